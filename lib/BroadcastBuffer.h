@@ -0,0 +1,216 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+template<typename T, typename alloc = std::allocator<T>>
+class BroadcastBuffer {
+    static constexpr size_t kWords = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    struct Slot {
+        std::atomic<uint64_t> version;
+        std::array<std::atomic<uint64_t>, kWords> words;
+    };
+
+    using slot_allocator = typename std::allocator_traits<alloc>::template rebind_alloc<Slot>;
+    using slot_traits = std::allocator_traits<slot_allocator>;
+
+public:
+    using const_reference = const T&;
+
+    struct Batch {
+        uint64_t first;
+        size_t count;
+    };
+
+    class alignas(64) Reader {
+    public:
+        explicit Reader(BroadcastBuffer* buffer, uint64_t cursor) : buffer_(buffer), cursor_(cursor) {}
+
+        size_t available() const {
+            return buffer_->published_.load(std::memory_order_acquire) - cursor_.load(std::memory_order_relaxed);
+        }
+
+        Batch claim(const size_t max = std::numeric_limits<size_t>::max()) {
+            uint64_t published = buffer_->published_.load(std::memory_order_acquire);
+            uint64_t cursor = cursor_.load(std::memory_order_relaxed);
+
+            if (published - cursor > buffer_->capacity_) {
+                overruns_ += published - cursor - buffer_->capacity_;
+                cursor = published - buffer_->capacity_;
+                cursor_.store(cursor, std::memory_order_release);
+            }
+
+            return {cursor, static_cast<size_t>(std::min<uint64_t>(published - cursor, max))};
+        }
+
+        T operator[](const uint64_t sequence) const {
+            return buffer_->load(sequence);
+        }
+
+        // In lossy mode a false result means the batch was overwritten while it was read; the
+        // copies taken through operator[] since claim must then be discarded, as try_read does.
+        bool release(const Batch& batch) {
+            if (buffer_->lossy_ && batch.count != 0) {
+                std::atomic_thread_fence(std::memory_order_acquire);
+
+                if (buffer_->slots_[batch.first & buffer_->mask_].version.load(std::memory_order_relaxed) !=
+                    stamp(batch.first)) {
+                    overruns_ += batch.count;
+                    cursor_.store(batch.first + batch.count, std::memory_order_release);
+                    return false;
+                }
+            }
+
+            cursor_.store(batch.first + batch.count, std::memory_order_release);
+            return true;
+        }
+
+        bool try_read(T& element) {
+            while (true) {
+                Batch batch = claim(1);
+                if (batch.count == 0) {
+                    return false;
+                }
+
+                element = (*this)[batch.first];
+                if (release(batch)) {
+                    return true;
+                }
+            }
+        }
+
+        size_t overruns() const {
+            return overruns_;
+        }
+
+    private:
+        friend class BroadcastBuffer;
+
+        BroadcastBuffer* buffer_;
+        std::atomic<uint64_t> cursor_;
+        size_t overruns_ = 0;
+    };
+
+    explicit BroadcastBuffer(const size_t size, const bool lossy = false) : capacity_(size),
+                                                                          mask_(capacity_ - 1),
+                                                                          lossy_(lossy),
+                                                                          published_(0),
+                                                                          gating_(0) {
+        static_assert(std::is_trivially_copyable_v<T>, "Broadcast ring requires a trivially copyable element type");
+
+        if (size == 0) {
+            throw ::std::invalid_argument("Buffer size not specified");
+        }
+        if (!std::has_single_bit(size)) {
+            throw ::std::invalid_argument("Buffer size must be a power of two");
+        }
+
+        slots_ = memory_.allocate(capacity_);
+        for (size_t i = 0; i < capacity_; ++i) {
+            slot_traits::construct(memory_, slots_ + i);
+        }
+    }
+
+    BroadcastBuffer(const BroadcastBuffer& x) = delete;
+
+    BroadcastBuffer& operator=(const BroadcastBuffer& x) = delete;
+
+    ~BroadcastBuffer() {
+        for (size_t i = 0; i < capacity_; ++i) {
+            slot_traits::destroy(memory_, slots_ + i);
+        }
+        memory_.deallocate(slots_, capacity_);
+    }
+
+    Reader& add_reader() {
+        readers_.push_back(std::make_unique<Reader>(this, published_.load(std::memory_order_relaxed)));
+        return *readers_.back();
+    }
+
+    bool try_push(const_reference element) {
+        uint64_t sequence = published_.load(std::memory_order_relaxed);
+
+        if (!lossy_ && sequence - gating_ >= capacity_) {
+            gating_ = slowest();
+            if (sequence - gating_ >= capacity_) {
+                return false;
+            }
+        }
+
+        store(sequence, element);
+        published_.store(sequence + 1, std::memory_order_release);
+        return true;
+    }
+
+    void push(const_reference element) {
+        while (!try_push(element)) {
+            std::this_thread::yield();
+        }
+    }
+
+    size_t max_size() {
+        return capacity_;
+    }
+
+    size_t reader_count() {
+        return readers_.size();
+    }
+
+private:
+    static uint64_t stamp(const uint64_t sequence) {
+        return 2 * sequence + 2;
+    }
+
+    void store(const uint64_t sequence, const_reference element) {
+        Slot& slot = slots_[sequence & mask_];
+        uint64_t words[kWords] = {};
+        std::memcpy(words, &element, sizeof(T));
+
+        slot.version.store(stamp(sequence) - 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < kWords; ++i) {
+            slot.words[i].store(words[i], std::memory_order_relaxed);
+        }
+        slot.version.store(stamp(sequence), std::memory_order_release);
+    }
+
+    T load(const uint64_t sequence) const {
+        const Slot& slot = slots_[sequence & mask_];
+        uint64_t words[kWords];
+        for (size_t i = 0; i < kWords; ++i) {
+            words[i] = slot.words[i].load(std::memory_order_relaxed);
+        }
+
+        std::array<std::byte, sizeof(T)> bytes;
+        std::memcpy(bytes.data(), words, sizeof(T));
+        return std::bit_cast<T>(bytes);
+    }
+
+    uint64_t slowest() const {
+        uint64_t slowest = published_.load(std::memory_order_relaxed);
+        for (const std::unique_ptr<Reader>& reader: readers_) {
+            slowest = std::min(slowest, reader->cursor_.load(std::memory_order_acquire));
+        }
+        return slowest;
+    }
+
+    slot_allocator memory_;
+    Slot* slots_;
+    size_t capacity_;
+    size_t mask_;
+    bool lossy_;
+    std::vector<std::unique_ptr<Reader>> readers_;
+    alignas(64) std::atomic<uint64_t> published_;
+    uint64_t gating_;
+};
@@ -1,7 +1,23 @@
+#pragma once
+
 #include <iostream>
 #include <initializer_list>
 #include <memory>
 #include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <utility>
+
+#if __has_include(<sys/uio.h>)
+#include <sys/uio.h>
+#define BUFFER_HAS_FD_IO 1
+#else
+#define BUFFER_HAS_FD_IO 0
+#endif
 
 template<typename value_type>
 
@@ -14,11 +30,11 @@ public:
 
     explicit Iterator(pointer target) : target_(target) {}
 
-    explicit Iterator(pointer begin, size_t size) : begin_(begin), end_(begin + size + 1), target_(begin),
+    explicit Iterator(pointer begin, size_t size) : begin_(begin), end_(begin + size), target_(begin),
                                                     capacity_(size + 1) {}
 
-    explicit Iterator(pointer begin, size_t size, pointer target) : begin_(begin), end_(begin_ + size + 1),
-                                                                    target_(target) {}
+    explicit Iterator(pointer begin, size_t size, pointer target) : begin_(begin), end_(begin_ + size),
+                                                                    target_(target), capacity_(size + 1) {}
 
     Iterator(const Iterator<value_type>& x) {
         capacity_ = x.capacity_;
@@ -70,7 +86,7 @@ public:
     Iterator operator-(const size_t n) {
         Iterator<value_type> temp = *this;
         if (n > target_ - begin_) {
-            temp.target_ = temp.end_ - (n % capacity_);
+            temp.target_ = temp.end_ - (n - (target_ - begin_) - 1);
         } else {
             temp.target_ -= n;
         }
@@ -127,6 +143,10 @@ public:
         return (target_ >= x.target_);
     }
 
+    pointer base() const {
+        return target_;
+    }
+
     Iterator<const value_type> toConstIterator() const {
         return Iterator<const value_type>(target_, capacity_, begin_);
     }
@@ -192,39 +212,6 @@ public:
         end_ = Iterator(buffer_, capacity_, buffer_ + capacity_);
     }
 
-    Buffer& operator=(const Buffer& x) {
-        if (*this == x) {
-            return *this;
-        }
-
-        size_ = x.size_;
-        capacity_ = x.capacity_;
-
-        buffer_ = memory_.allocate(x.capacity_ + 1);
-        begin_ = Iterator(buffer_, capacity_);
-
-        Buffer::iterator it = begin_;
-        for (Buffer::iterator it_x = x.begin_; it_x != x.end_; ++it_x, ++it) {
-            *it = *it_x;
-        }
-        end_ = it;
-        return *this;
-    }
-
-    Buffer& operator=(const std::initializer_list<value_type>& list) {
-        capacity_ = list.size();
-
-        buffer_ = memory_.allocate(list.size() + 1);
-        begin_ = Iterator(buffer_, capacity_);
-
-        Buffer::iterator it = begin_;
-        for (auto it_list = list.begin(); it_list != list.end_; ++it_list, ++it) {
-            *it = *it_list;
-        }
-        end_ = it;
-        return *this;
-    }
-
     bool operator==(const Buffer<value_type>& x) {
         if (size_ != x.size_) {
             return false;
@@ -266,8 +253,6 @@ public:
         return end_.toConstIterator();
     }
 
-    virtual void push(const_reference element) {}
-
     void pop() {
         if (size_ == 0) {
             throw ::std::invalid_argument("Buffer is empty");
@@ -283,14 +268,112 @@ public:
 
     }
 
-    void swap(Buffer<value_type>& x) {
-        std::swap(capacity_, x.capacity_);
-        std::swap(begin_, x.begin_);
-        std::swap(end_, x.end_);
-        std::swap(buffer_, x.buffer_);
-        std::swap(size_, x.size_);
+    std::pair<std::span<value_type>, std::span<value_type>> segments() {
+        size_t head = begin_.base() - buffer_;
+        size_t first = std::min(size_, capacity_ + 1 - head);
+
+        return {std::span<value_type>(buffer_ + head, first), std::span<value_type>(buffer_, size_ - first)};
+    }
+
+    std::pair<std::span<value_type>, std::span<value_type>> free_segments() {
+        size_t free = capacity_ - size_;
+        size_t tail = end_.base() - buffer_;
+        size_t first = std::min(free, capacity_ + 1 - tail);
+
+        return {std::span<value_type>(buffer_ + tail, first), std::span<value_type>(buffer_, free - first)};
+    }
+
+    template<typename Key, typename KeyOf = std::identity>
+    size_t lower_bound_key(const Key& key, KeyOf key_of = {}) {
+        auto [first, second] = segments();
+        auto less = [&key_of](const value_type& element, const Key& x) { return key_of(element) < x; };
+
+        if (!second.empty() && key_of(first.back()) < key) {
+            return first.size() + (std::lower_bound(second.begin(), second.end(), key, less) - second.begin());
+        }
+        return std::lower_bound(first.begin(), first.end(), key, less) - first.begin();
+    }
+
+    template<typename Key, typename KeyOf = std::identity>
+    std::pair<std::span<value_type>, std::span<value_type>> range(const Key& from, const Key& to, KeyOf key_of = {}) {
+        size_t left = lower_bound_key(from, key_of);
+        size_t right = std::max(left, lower_bound_key(to, key_of));
+
+        auto [first, second] = segments();
+        size_t split = first.size();
+
+        return {first.subspan(std::min(left, split), std::min(right, split) - std::min(left, split)),
+                second.subspan(std::max(left, split) - split, std::max(right, split) - std::max(left, split))};
+    }
+
+    template<typename Key, typename KeyOf = std::identity>
+    size_t expire_before(const Key& key, KeyOf key_of = {}) {
+        size_t count = lower_bound_key(key, key_of);
+
+        begin_ += count;
+        size_ -= count;
+
+        if (size_ == 0) {
+            end_ = begin_;
+        }
+
+        return count;
     }
 
+#if BUFFER_HAS_FD_IO
+    ssize_t read_from(const int fd, const size_t max) {
+        static_assert(sizeof(value_type) == 1, "Direct fd I/O requires a byte-sized element type");
+
+        if (size_ == capacity_) {
+            throw ::std::invalid_argument("Buffer is full");
+        }
+
+        auto [first, second] = free_segments();
+
+        iovec io[2];
+        int count = fill_io(io, first, second, max);
+        if (count == 0) {
+            return 0;
+        }
+
+        ssize_t bytes = ::readv(fd, io, count);
+        if (bytes > 0) {
+            end_ += bytes;
+            size_ += bytes;
+        }
+
+        return bytes;
+    }
+
+    ssize_t write_to(const int fd, const size_t max) {
+        static_assert(sizeof(value_type) == 1, "Direct fd I/O requires a byte-sized element type");
+
+        if (size_ == 0) {
+            throw ::std::invalid_argument("Buffer is empty");
+        }
+
+        auto [first, second] = segments();
+
+        iovec io[2];
+        int count = fill_io(io, first, second, max);
+        if (count == 0) {
+            return 0;
+        }
+
+        ssize_t bytes = ::writev(fd, io, count);
+        if (bytes > 0) {
+            begin_ += bytes;
+            size_ -= bytes;
+
+            if (size_ == 0) {
+                end_ = begin_;
+            }
+        }
+
+        return bytes;
+    }
+#endif
+
     size_t size() {
         return size_;
     }
@@ -308,6 +391,76 @@ public:
     }
 
 protected:
+    Buffer& operator=(const Buffer& x) {
+        if (this == &x) {
+            return *this;
+        }
+
+        release_storage();
+
+        size_ = x.size_;
+        capacity_ = x.capacity_;
+
+        buffer_ = memory_.allocate(x.capacity_ + 1);
+        begin_ = Iterator(buffer_, capacity_);
+
+        Buffer::iterator it = begin_;
+        for (Buffer::iterator it_x = x.begin_; it_x != x.end_; ++it_x, ++it) {
+            *it = *it_x;
+        }
+        end_ = it;
+        return *this;
+    }
+
+    Buffer& operator=(const std::initializer_list<value_type>& list) {
+        release_storage();
+
+        capacity_ = list.size();
+        size_ = list.size();
+
+        buffer_ = memory_.allocate(list.size() + 1);
+        begin_ = Iterator(buffer_, capacity_);
+
+        Buffer::iterator it = begin_;
+        for (auto it_list = list.begin(); it_list != list.end(); ++it_list, ++it) {
+            *it = *it_list;
+        }
+        end_ = it;
+        return *this;
+    }
+
+    void swap(Buffer& x) {
+        std::swap(capacity_, x.capacity_);
+        std::swap(begin_, x.begin_);
+        std::swap(end_, x.end_);
+        std::swap(buffer_, x.buffer_);
+        std::swap(size_, x.size_);
+    }
+
+    void release_storage() {
+        memory_.deallocate(buffer_, capacity_ + 1);
+        buffer_ = nullptr;
+    }
+
+#if BUFFER_HAS_FD_IO
+    static int fill_io(iovec* io, std::span<value_type> first, std::span<value_type> second, size_t max) {
+        int count = 0;
+
+        size_t length = std::min(first.size(), max);
+        if (length != 0) {
+            io[count++] = {first.data(), length};
+            max -= length;
+        }
+
+        length = std::min(second.size(), max);
+        if (length != 0) {
+            io[count++] = {second.data(), length};
+        }
+
+        return count;
+    }
+#endif
+
     alloc memory_;
     pointer buffer_;
     size_t capacity_;
@@ -316,39 +469,434 @@ protected:
     size_t size_;
 };
 
-template<typename T, typename alloc = std::allocator<T>>
-class BufferStatic : public Buffer<T, alloc> {
+struct OverwriteOldest {
+    template<typename Container>
+    static bool make_room(Container& buffer) {
+        buffer.pop();
+        return true;
+    }
+};
+
+struct RejectNewest {
+    template<typename Container>
+    static bool make_room(Container&) {
+        return false;
+    }
+};
+
+template<typename T, typename Overflow, typename alloc = std::allocator<T>>
+class BufferBounded : public Buffer<T, alloc> {
 public:
     using iterator = Iterator<T>;
     using pointer = T*;
     using reverence = T&;
     using const_reverence = const T&;
 
-    explicit BufferStatic() : Buffer<T, alloc>() {}
+    explicit BufferBounded() : Buffer<T, alloc>() {}
 
-    BufferStatic(const BufferStatic& x) : Buffer<T, alloc>(x) {}
+    BufferBounded(const BufferBounded& x) : Buffer<T, alloc>(x) {}
 
-    BufferStatic(const std::initializer_list<T>& list) : Buffer<T, alloc>(list) {}
+    BufferBounded& operator=(const BufferBounded& x) {
+        Buffer<T, alloc>::operator=(x);
+        return *this;
+    }
 
-    explicit BufferStatic(const size_t size) : Buffer<T, alloc>(size) {}
+    BufferBounded(const std::initializer_list<T>& list) : Buffer<T, alloc>(list) {}
 
-    void push(const_reverence element) override {
-        if (this->buffer_ == nullptr) {
+    explicit BufferBounded(const size_t size) : Buffer<T, alloc>(size) {}
+
+    void swap(BufferBounded& x) {
+        Buffer<T, alloc>::swap(x);
+    }
+
+    bool push(const_reverence element) {
+        if (this->buffer_ == nullptr || this->capacity_ == 0) {
             throw ::std::invalid_argument("Buffer size not specified");
         }
 
+        if (this->size_ == this->capacity_ && !Overflow::make_room(static_cast<Buffer<T, alloc>&>(*this))) {
+            return false;
+        }
+
         *(this->end_) = element;
         ++(this->end_);
+        (this->size_)++;
+        return true;
+    }
+};
 
-        if (this->size_ == this->capacity_) {
-            ++(this->begin_);
+template<typename T, typename alloc = std::allocator<T>>
+class BufferStatic : public BufferBounded<T, OverwriteOldest, alloc> {
+public:
+    explicit BufferStatic() : BufferBounded<T, OverwriteOldest, alloc>() {}
+
+    BufferStatic(const BufferStatic& x) : BufferBounded<T, OverwriteOldest, alloc>(x) {}
+
+    BufferStatic& operator=(const BufferStatic& x) {
+        BufferBounded<T, OverwriteOldest, alloc>::operator=(x);
+        return *this;
+    }
+
+    BufferStatic(const std::initializer_list<T>& list) : BufferBounded<T, OverwriteOldest, alloc>(list) {}
+
+    explicit BufferStatic(const size_t size) : BufferBounded<T, OverwriteOldest, alloc>(size) {}
+};
+
+template<typename T, typename alloc = std::allocator<T>>
+using BufferRejecting = BufferBounded<T, RejectNewest, alloc>;
+
+class BitReference {
+public:
+    explicit BitReference(uint64_t* word, const uint64_t mask) : word_(word), mask_(mask) {}
+
+    BitReference(const BitReference& x) = default;
+
+    BitReference& operator=(const bool value) {
+        if (value) {
+            *word_ |= mask_;
         } else {
-            (this->size_)++;
+            *word_ &= ~mask_;
+        }
+        return *this;
+    }
+
+    BitReference& operator=(const BitReference& x) {
+        return *this = static_cast<bool>(x);
+    }
+
+    operator bool() const {
+        return (*word_ & mask_) != 0;
+    }
+
+    void flip() {
+        *word_ ^= mask_;
+    }
+
+private:
+    uint64_t* word_;
+    uint64_t mask_;
+};
+
+class BitIterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = bool;
+    using difference_type = std::ptrdiff_t;
+    using reference = BitReference;
+    using pointer = void;
+
+    BitIterator() = default;
+
+    explicit BitIterator(uint64_t* words, size_t capacity, size_t head, size_t index) : words_(words),
+                                                                                        capacity_(capacity),
+                                                                                        head_(head),
+                                                                                        index_(index) {}
+
+    BitIterator& operator++() {
+        ++index_;
+        return *this;
+    }
+
+    BitIterator& operator--() {
+        --index_;
+        return *this;
+    }
+
+    BitIterator operator+(const size_t n) const {
+        return BitIterator(words_, capacity_, head_, index_ + n);
+    }
+
+    BitIterator operator-(const size_t n) const {
+        return BitIterator(words_, capacity_, head_, index_ - n);
+    }
+
+    BitIterator& operator+=(const int64_t n) {
+        index_ += n;
+        return *this;
+    }
+
+    size_t operator-(const BitIterator& x) const {
+        return index_ - x.index_;
+    }
+
+    reference operator*() const {
+        size_t position = head_ + index_;
+        if (position >= capacity_) {
+            position -= capacity_;
         }
+        return BitReference(words_ + (position >> 6), uint64_t(1) << (position & 63));
+    }
+
+    bool operator==(const BitIterator& x) const {
+        return index_ == x.index_;
+    }
+
+    bool operator!=(const BitIterator& x) const {
+        return !(*this == x);
+    }
+
+    bool operator<(const BitIterator& x) const {
+        return index_ < x.index_;
     }
+
+private:
+    uint64_t* words_ = nullptr;
+    size_t capacity_ = 0;
+    size_t head_ = 0;
+    size_t index_ = 0;
 };
 
-template<typename T, typename alloc = std::allocator<T>>
+template<typename alloc>
+class BufferStatic<bool, alloc> {
+public:
+    using iterator = BitIterator;
+    using reference = BitReference;
+    using word_allocator = typename std::allocator_traits<alloc>::template rebind_alloc<uint64_t>;
+
+    explicit BufferStatic() : words_(nullptr), capacity_(0), head_(0), size_(0) {}
+
+    BufferStatic(const BufferStatic& x) : capacity_(x.capacity_), head_(x.head_), size_(x.size_) {
+        words_ = allocate(capacity_);
+        std::copy(x.words_, x.words_ + word_count(capacity_), words_);
+    }
+
+    BufferStatic(const std::initializer_list<bool>& list) : capacity_(list.size()), head_(0), size_(0) {
+        words_ = allocate(capacity_);
+        for (bool element: list) {
+            push(element);
+        }
+    }
+
+    explicit BufferStatic(const size_t size) : capacity_(size), head_(0), size_(0) {
+        words_ = allocate(capacity_);
+    }
+
+    BufferStatic& operator=(const BufferStatic& x) {
+        if (this == &x) {
+            return *this;
+        }
+
+        BufferStatic copy(x);
+        swap(copy);
+        return *this;
+    }
+
+    bool operator==(const BufferStatic& x) {
+        if (size_ != x.size_) {
+            return false;
+        }
+        for (size_t i = 0; i < size_; ++i) {
+            if (test(i) != x.test(i)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool operator!=(const BufferStatic& x) {
+        return !(*this == x);
+    }
+
+    reference operator[](const size_t n) {
+        if (n < size_) {
+            return *(begin() + n);
+        } else {
+            throw std::invalid_argument("Going beyond the boundaries of the container");
+        }
+    }
+
+    iterator begin() {
+        return BitIterator(words_, capacity_, head_, 0);
+    }
+
+    iterator end() {
+        return BitIterator(words_, capacity_, head_, size_);
+    }
+
+    void push(const bool element) {
+        push_bits(element ? 1 : 0, 1);
+    }
+
+    void push_bits(uint64_t bits, size_t count) {
+        if (words_ == nullptr) {
+            throw ::std::invalid_argument("Buffer size not specified");
+        }
+        if (count > 64) {
+            throw ::std::invalid_argument("At most 64 bits can be pushed at once");
+        }
+
+        if (count > capacity_) {
+            bits >>= count - capacity_;
+            count = capacity_;
+        }
+
+        size_t tail = position(size_);
+        size_t first = std::min(count, capacity_ - tail);
+        write_bits(tail, bits, first);
+        if (count > first) {
+            write_bits(0, bits >> first, count - first);
+        }
+
+        size_ += count;
+        if (size_ > capacity_) {
+            head_ = position(size_ - capacity_);
+            size_ = capacity_;
+        }
+    }
+
+    void pop() {
+        if (size_ == 0) {
+            throw ::std::invalid_argument("Buffer is empty");
+        }
+
+        head_ = position(1);
+        size_--;
+    }
+
+    size_t count() const {
+        size_t first = std::min(size_, capacity_ - head_);
+        return count_bits(head_, head_ + first) + count_bits(0, size_ - first);
+    }
+
+    bool any() const {
+        return count() != 0;
+    }
+
+    bool all() const {
+        return count() == size_;
+    }
+
+    void clear() {
+        head_ = 0;
+        size_ = 0;
+    }
+
+    void swap(BufferStatic& x) {
+        std::swap(words_, x.words_);
+        std::swap(capacity_, x.capacity_);
+        std::swap(head_, x.head_);
+        std::swap(size_, x.size_);
+    }
+
+    size_t size() {
+        return size_;
+    }
+
+    size_t max_size() {
+        return capacity_;
+    }
+
+    bool empty() {
+        return size_ == 0;
+    }
+
+    ~BufferStatic() {
+        if (words_ != nullptr) {
+            memory_.deallocate(words_, word_count(capacity_));
+        }
+    }
+
+private:
+    static size_t word_count(const size_t bits) {
+        return (bits + 63) / 64;
+    }
+
+    static uint64_t low_mask(const size_t count) {
+        return count == 64 ? ~uint64_t(0) : (uint64_t(1) << count) - 1;
+    }
+
+    uint64_t* allocate(const size_t bits) {
+        if (bits == 0) {
+            return nullptr;
+        }
+
+        uint64_t* words = memory_.allocate(word_count(bits));
+        std::fill(words, words + word_count(bits), 0);
+        return words;
+    }
+
+    size_t position(const size_t n) const {
+        size_t bit = head_ + n;
+        return bit >= capacity_ ? bit - capacity_ : bit;
+    }
+
+    bool test(const size_t n) const {
+        size_t bit = position(n);
+        return (words_[bit >> 6] >> (bit & 63)) & 1;
+    }
+
+    void write_bits(const size_t from, uint64_t bits, const size_t count) {
+        size_t word = from >> 6;
+        size_t shift = from & 63;
+        bits &= low_mask(count);
+
+        words_[word] = (words_[word] & ~(low_mask(count) << shift)) | (bits << shift);
+        if (shift + count > 64) {
+            uint64_t spill = low_mask(shift + count - 64);
+            words_[word + 1] = (words_[word + 1] & ~spill) | (bits >> (64 - shift));
+        }
+    }
+
+    size_t count_bits(size_t from, const size_t to) const {
+        size_t total = 0;
+        while (from < to) {
+            size_t shift = from & 63;
+            size_t length = std::min(64 - shift, to - from);
+            total += std::popcount(words_[from >> 6] & (low_mask(length) << shift));
+            from += length;
+        }
+        return total;
+    }
+
+    word_allocator memory_;
+    uint64_t* words_;
+    size_t capacity_;
+    size_t head_;
+    size_t size_;
+};
+
+template<typename T>
+class BufferSnapshot {
+public:
+    using iterator = Iterator<const T>;
+    using const_reference = const T&;
+
+    BufferSnapshot() : size_(0) {}
+
+    explicit BufferSnapshot(std::shared_ptr<T> storage, const T* target, size_t capacity, size_t size)
+            : storage_(std::move(storage)), begin_(storage_.get(), capacity, target), size_(size) {}
+
+    const_reference operator[](const size_t n) const {
+        if (n < size_) {
+            return *(iterator(begin_) + n);
+        } else {
+            throw std::invalid_argument("Going beyond the boundaries of the container");
+        }
+    }
+
+    iterator begin() const {
+        return begin_;
+    }
+
+    iterator end() const {
+        return iterator(begin_) + size_;
+    }
+
+    size_t size() const {
+        return size_;
+    }
+
+    bool empty() const {
+        return size_ == 0;
+    }
+
+private:
+    std::shared_ptr<T> storage_;
+    iterator begin_;
+    size_t size_;
+};
+
+template<typename T, typename alloc = std::allocator<T>, size_t N = 0>
 class BufferDynamic : public Buffer<T, alloc> {
 public:
     using iterator = Iterator<T>;
@@ -358,38 +906,51 @@ public:
 
     explicit BufferDynamic() : Buffer<T, alloc>() {}
 
-    BufferDynamic(const BufferDynamic& x) : Buffer<T, alloc>(x) {}
-
-    BufferDynamic(const std::initializer_list<T>& list) : Buffer<T, alloc>(list) {}
+    BufferDynamic(const BufferDynamic& x) : Buffer<T, alloc>(), auto_shrink_(x.auto_shrink_),
+                                             max_capacity_(x.max_capacity_) {
+        if (x.buffer_ == nullptr) {
+            return;
+        }
 
-    explicit BufferDynamic(const size_t size) : Buffer<T, alloc>(size) {}
+        initialize(x.capacity_);
+        for (BufferDynamic::iterator it = x.begin_; it != x.end_; ++it) {
+            append(*it);
+        }
+    }
 
-    BufferDynamic(const size_t n, const_reverence element) {
-        this->capacity_ = n;
-        this->size_ = n;
-        this->buffer_ = this->memory_.allocate(n + 1);
-        this->begin_ = iterator(this->buffer_, n);
-        size_t index = 0;
-        for (index; index < n; ++index) {
-            this->buffer_[index] = element;
+    BufferDynamic& operator=(const BufferDynamic& x) {
+        if (this == &x) {
+            return *this;
         }
-        this->end_ = Iterator(this->buffer_, this->capacity_, this->buffer_ + index);
+
+        BufferDynamic copy(x);
+        swap(copy);
+        return *this;
     }
 
-    BufferDynamic(BufferDynamic::iterator new_begin, BufferDynamic::iterator new_end) {
-        size_t new_size = new_end - new_begin;
-        this->capacity_ = new_size;
-        this->size_ = new_size;
+    BufferDynamic(const std::initializer_list<T>& list) : Buffer<T, alloc>() {
+        initialize(list.size());
+        for (const T& element: list) {
+            append(element);
+        }
+    }
 
-        this->buffer_ = this->memory_.allocate(new_size + 1);
-        this->begin_ = iterator(this->buffer_, new_size);
+    explicit BufferDynamic(const size_t size) : Buffer<T, alloc>() {
+        initialize(size);
+    }
 
-        size_t index = 0;
-        for (new_begin; new_begin < new_end; ++new_begin, ++index) {
-            this->buffer_[index] = *new_begin;
+    BufferDynamic(const size_t n, const_reverence element) : Buffer<T, alloc>() {
+        initialize(n);
+        for (size_t index = 0; index < n; ++index) {
+            append(element);
         }
+    }
 
-        this->end_ = Iterator(this->buffer_, this->capacity_, this->buffer_ + index);
+    BufferDynamic(BufferDynamic::iterator new_begin, BufferDynamic::iterator new_end) : Buffer<T, alloc>() {
+        initialize(new_end - new_begin);
+        for (new_begin; new_begin < new_end; ++new_begin) {
+            append(*new_begin);
+        }
     }
 
     iterator insert(const size_t pos, const_reverence element) {
@@ -418,7 +979,7 @@ public:
             new_buffer[index] = *tmp_it;
         }
 
-        this->memory_.deallocate(this->buffer_, this->capacity_ + 1);
+        release_storage();
 
         this->capacity_ = this->capacity_ * 2;
 
@@ -462,7 +1023,7 @@ public:
             new_buffer[index] = *tmp_it;
         }
 
-        this->memory_.deallocate(this->buffer_, this->capacity_ + 1);
+        release_storage();
 
         this->size_ += count;
         this->capacity_ = this->size_;
@@ -507,7 +1068,7 @@ public:
             new_buffer[index] = *tmp_it;
         }
 
-        this->memory_.deallocate(this->buffer_, this->capacity_ + 1);
+        release_storage();
 
         this->size_ += list.size();
         this->capacity_ = this->size_;
@@ -524,7 +1085,7 @@ public:
 
     void assign(BufferDynamic::iterator left_border, BufferDynamic::iterator right_border) {
         if (this->capacity_ != 0) {
-            this->memory_.deallocate(this->buffer_, this->capacity_ + 1);
+            release_storage();
         }
         this->capacity_ = right_border - left_border;
 
@@ -541,7 +1102,7 @@ public:
 
     void assign(const std::initializer_list<T>& list) {
         if (this->capacity_ != 0) {
-            this->memory_.deallocate(this->buffer_, this->capacity_ + 1);
+            release_storage();
         }
         this->capacity_ = list.size();
 
@@ -558,7 +1119,7 @@ public:
 
     void assign(const size_t count, const_reverence element) {
         if (this->capacity_ != 0) {
-            this->memory_.deallocate(this->buffer_, this->capacity_ + 1);
+            release_storage();
         }
         this->capacity_ = count;
         this->buffer_ = (this->memory_).allocate(this->capacity_ + 1);
@@ -572,41 +1133,250 @@ public:
         }
     }
 
-    void push(const_reverence element) override {
+    void push(const_reverence element) {
         if (this->buffer_ == nullptr) {
-            this->capacity_ = 1;
-            this->buffer_ = (this->memory_).allocate(this->capacity_ + 1);
+            if (N != 0) {
+                this->capacity_ = max_capacity_ != 0 ? std::min(N, max_capacity_) : N;
+                this->buffer_ = local_buffer();
+            } else {
+                this->capacity_ = 1;
+                this->buffer_ = (this->memory_).allocate(this->capacity_ + 1);
+            }
             this->begin_ = Iterator(this->buffer_, this->capacity_);
             this->end_ = this->begin_;
         }
 
+        if (pinned_ == this->end_.base()) {
+            detach();
+        }
+
+        if (this->size_ == this->capacity_) {
+            if (max_capacity_ != 0 && this->capacity_ >= max_capacity_) {
+                *(this->end_) = element;
+                ++(this->end_);
+                ++(this->begin_);
+                return;
+            }
+
+            size_t new_capacity = std::max<size_t>(this->capacity_ * 2, 1);
+            if (max_capacity_ != 0) {
+                new_capacity = std::min(new_capacity, max_capacity_);
+            }
+            reallocate(new_capacity);
+        }
+
+        *(this->end_) = element;
+        ++(this->end_);
+        this->size_++;
+    }
+
+    void pop() {
+        Buffer<T, alloc>::pop();
+
+        if (auto_shrink_ && this->capacity_ > kMinShrinkCapacity && this->size_ < this->capacity_ / 4) {
+            reallocate(this->capacity_ / 2);
+        }
+    }
+
+    void clear() {
+        size_t size = this->size_;
+        for (size_t i = 0; i < size; ++i) {
+            Buffer<T, alloc>::pop();
+        }
+
+        if (auto_shrink_) {
+            shrink_to_fit();
+        }
+    }
+
+    void shrink_to_fit() {
         if (this->size_ == this->capacity_) {
-            pointer new_buffer = (this->memory_).allocate(this->capacity_ * 2 + 1);
+            return;
+        }
+
+        if (this->size_ == 0) {
+            release_storage();
+            this->capacity_ = 0;
+            this->buffer_ = nullptr;
+            this->begin_ = iterator();
+            this->end_ = iterator();
+            return;
+        }
+
+        reallocate(this->size_);
+    }
+
+    void set_auto_shrink(const bool enabled) {
+        auto_shrink_ = enabled;
+    }
+
+    void set_max_capacity(const size_t max_capacity) {
+        max_capacity_ = max_capacity;
 
-            size_t index = 0;
-            for (BufferDynamic::iterator it = this->begin_; it != this->end_; ++it, ++index) {
-                new_buffer[index] = *it;
+        if (max_capacity_ == 0 || this->capacity_ <= max_capacity_) {
+            return;
+        }
+
+        while (this->size_ > max_capacity_) {
+            Buffer<T, alloc>::pop();
+        }
+        reallocate(max_capacity_);
+    }
+
+    size_t max_capacity() {
+        return max_capacity_;
+    }
+
+#if BUFFER_HAS_FD_IO
+    ssize_t read_from(const int fd, const size_t max) {
+        if (pinned_ != nullptr) {
+            size_t slots = this->capacity_ + 1;
+            size_t distance = (pinned_ - this->end_.base() + slots) % slots;
+
+            if (distance < std::min(max, this->capacity_ - this->size_)) {
+                detach();
             }
+        }
+
+        return Buffer<T, alloc>::read_from(fd, max);
+    }
+#endif
+
+    BufferSnapshot<T> snapshot() {
+        if (this->buffer_ == nullptr) {
+            return BufferSnapshot<T>();
+        }
+
+        if (is_local()) {
+            reallocate(this->capacity_, true);
+        }
+
+        if (storage_.use_count() <= 1) {
+            pinned_ = this->begin_.base();
+        }
+        share_storage();
+
+        return BufferSnapshot<T>(storage_, this->begin_.base(), this->capacity_, this->size_);
+    }
+
+    void swap(BufferDynamic& x) {
+        if (is_local()) {
+            reallocate(this->capacity_, true);
+        }
+        if (x.is_local()) {
+            x.reallocate(x.capacity_, true);
+        }
+
+        Buffer<T, alloc>::swap(x);
+        std::swap(storage_, x.storage_);
+        std::swap(pinned_, x.pinned_);
+        std::swap(auto_shrink_, x.auto_shrink_);
+        std::swap(max_capacity_, x.max_capacity_);
+    }
+
+    ~BufferDynamic() {
+        release_storage();
+    }
+
+private:
+    void release_storage() {
+        if (storage_) {
+            storage_.reset();
+        } else if (!is_local()) {
             this->memory_.deallocate(this->buffer_, this->capacity_ + 1);
+        }
 
-            this->capacity_ = this->capacity_ * 2;
+        this->buffer_ = nullptr;
+        pinned_ = nullptr;
+    }
 
-            this->buffer_ = new_buffer;
+    void share_storage() {
+        if (!storage_) {
+            storage_ = std::shared_ptr<T>(this->buffer_, [memory = this->memory_, size = this->capacity_ + 1](pointer p) mutable {
+                memory.deallocate(p, size);
+            });
+        }
+    }
 
-            this->begin_ = Iterator(this->buffer_, this->capacity_);
+    void detach() {
+        if (storage_.use_count() > 1) {
+            reallocate(this->capacity_);
+        } else {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            pinned_ = nullptr;
+        }
+    }
+
+    static constexpr size_t kMinShrinkCapacity = 16;
 
-            this->end_ = Iterator(this->buffer_, this->capacity_, this->buffer_ + index);
+    pointer local_buffer() {
+        if constexpr (N != 0) {
+            return reinterpret_cast<pointer>(inline_.bytes);
+        } else {
+            return nullptr;
         }
+    }
 
+    bool is_local() {
+        return N != 0 && this->buffer_ == local_buffer();
+    }
+
+    void initialize(const size_t capacity) {
+        this->capacity_ = capacity;
+        this->size_ = 0;
+        this->buffer_ = N != 0 && capacity <= N ? local_buffer() : (this->memory_).allocate(capacity + 1);
+        this->begin_ = Iterator(this->buffer_, this->capacity_);
+        this->end_ = this->begin_;
+    }
+
+    void append(const_reverence element) {
         *(this->end_) = element;
         ++(this->end_);
         this->size_++;
     }
 
-    void clear() {
-        size_t size = this->size_;
-        for (size_t i = 0; i < size; ++i) {
-            this->pop();
+    void reallocate(const size_t new_capacity, const bool to_heap = false) {
+        if (!to_heap && new_capacity <= N && is_local()) {
+            std::rotate(this->buffer_, this->begin_.base(), this->buffer_ + this->capacity_ + 1);
+
+            this->capacity_ = new_capacity;
+
+            this->begin_ = Iterator(this->buffer_, this->capacity_);
+
+            this->end_ = Iterator(this->buffer_, this->capacity_, this->buffer_ + this->size_);
+            return;
         }
+
+        bool to_local = N != 0 && !to_heap && new_capacity <= N;
+        pointer new_buffer = to_local ? local_buffer() : (this->memory_).allocate(new_capacity + 1);
+
+        size_t index = 0;
+        for (BufferDynamic::iterator it = this->begin_; it != this->end_; ++it, ++index) {
+            new_buffer[index] = *it;
+        }
+        release_storage();
+
+        this->capacity_ = new_capacity;
+
+        this->buffer_ = new_buffer;
+
+        this->begin_ = Iterator(this->buffer_, this->capacity_);
+
+        this->end_ = Iterator(this->buffer_, this->capacity_, this->buffer_ + index);
     }
+
+    struct NoStorage {};
+
+    struct alignas(T) InlineStorage {
+        std::byte bytes[(N + 1) * sizeof(T)];
+    };
+
+    std::shared_ptr<T> storage_;
+    pointer pinned_ = nullptr;
+    bool auto_shrink_ = false;
+    size_t max_capacity_ = 0;
+    [[no_unique_address]] std::conditional_t<N == 0, NoStorage, InlineStorage> inline_;
 };
+
+template<typename T, size_t N>
+using SmallBufferDynamic = BufferDynamic<T, std::allocator<T>, N>;
@@ -0,0 +1,257 @@
+#pragma once
+
+#include <bit>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+
+template<typename T, size_t BlockSize = 64, typename alloc = std::allocator<T>>
+class BufferChunked {
+    static_assert(std::has_single_bit(BlockSize), "Block size must be a power of two");
+
+    using traits = std::allocator_traits<alloc>;
+    using map_allocator = typename traits::template rebind_alloc<T*>;
+
+    static constexpr size_t kShift = std::countr_zero(BlockSize);
+    static constexpr size_t kMask = BlockSize - 1;
+
+public:
+    using pointer = T*;
+    using reference = T&;
+    using const_reference = const T&;
+
+    class iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        iterator() = default;
+
+        explicit iterator(BufferChunked* buffer, size_t index) : buffer_(buffer), index_(index) {}
+
+        iterator& operator++() {
+            ++index_;
+            return *this;
+        }
+
+        iterator& operator--() {
+            --index_;
+            return *this;
+        }
+
+        iterator operator+(const size_t n) const {
+            return iterator(buffer_, index_ + n);
+        }
+
+        iterator operator-(const size_t n) const {
+            return iterator(buffer_, index_ - n);
+        }
+
+        iterator& operator+=(const int64_t n) {
+            index_ += n;
+            return *this;
+        }
+
+        difference_type operator-(const iterator& x) const {
+            return index_ - x.index_;
+        }
+
+        reference operator*() const {
+            return buffer_->at(index_);
+        }
+
+        reference operator[](const size_t n) const {
+            return buffer_->at(index_ + n);
+        }
+
+        bool operator==(const iterator& x) const {
+            return index_ == x.index_;
+        }
+
+        bool operator!=(const iterator& x) const {
+            return !(*this == x);
+        }
+
+        bool operator<(const iterator& x) const {
+            return index_ < x.index_;
+        }
+
+    private:
+        BufferChunked* buffer_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    BufferChunked() : map_(nullptr), map_capacity_(0), map_head_(0), block_count_(0), spare_(nullptr), start_(0),
+                      size_(0) {}
+
+    BufferChunked(const BufferChunked& x) : BufferChunked() {
+        for (size_t i = 0; i < x.size_; ++i) {
+            push(x.at(i));
+        }
+    }
+
+    BufferChunked(const std::initializer_list<T>& list) : BufferChunked() {
+        for (const T& element: list) {
+            push(element);
+        }
+    }
+
+    BufferChunked& operator=(const BufferChunked& x) {
+        if (this == &x) {
+            return *this;
+        }
+
+        BufferChunked copy(x);
+        swap(copy);
+        return *this;
+    }
+
+    reference operator[](const size_t n) {
+        if (n < size_) {
+            return at(n);
+        } else {
+            throw std::invalid_argument("Going beyond the boundaries of the container");
+        }
+    }
+
+    iterator begin() {
+        return iterator(this, 0);
+    }
+
+    iterator end() {
+        return iterator(this, size_);
+    }
+
+    void push(const_reference element) {
+        size_t slot = start_ + size_;
+        if (slot == block_count_ * BlockSize) {
+            add_block();
+        }
+
+        traits::construct(memory_, &block(slot >> kShift)[slot & kMask], element);
+        ++size_;
+    }
+
+    void pop() {
+        if (size_ == 0) {
+            throw ::std::invalid_argument("Buffer is empty");
+        }
+
+        traits::destroy(memory_, &block(0)[start_]);
+        --size_;
+
+        if (++start_ == BlockSize) {
+            release_front();
+            start_ = 0;
+        }
+
+        if (size_ == 0) {
+            start_ = 0;
+        }
+    }
+
+    void clear() {
+        while (size_ != 0) {
+            pop();
+        }
+    }
+
+    void swap(BufferChunked& x) {
+        std::swap(map_, x.map_);
+        std::swap(map_capacity_, x.map_capacity_);
+        std::swap(map_head_, x.map_head_);
+        std::swap(block_count_, x.block_count_);
+        std::swap(spare_, x.spare_);
+        std::swap(start_, x.start_);
+        std::swap(size_, x.size_);
+    }
+
+    size_t size() {
+        return size_;
+    }
+
+    size_t max_size() {
+        return block_count_ * BlockSize - start_;
+    }
+
+    bool empty() {
+        return size_ == 0;
+    }
+
+    ~BufferChunked() {
+        clear();
+
+        for (size_t i = 0; i < block_count_; ++i) {
+            memory_.deallocate(block(i), BlockSize);
+        }
+        if (spare_ != nullptr) {
+            memory_.deallocate(spare_, BlockSize);
+        }
+        if (map_ != nullptr) {
+            map_allocator(memory_).deallocate(map_, map_capacity_);
+        }
+    }
+
+private:
+    pointer& block(const size_t n) const {
+        return map_[(map_head_ + n) & (map_capacity_ - 1)];
+    }
+
+    reference at(const size_t n) const {
+        size_t slot = start_ + n;
+        return block(slot >> kShift)[slot & kMask];
+    }
+
+    void add_block() {
+        if (block_count_ == map_capacity_) {
+            grow_map();
+        }
+
+        pointer fresh = spare_ != nullptr ? spare_ : memory_.allocate(BlockSize);
+        spare_ = nullptr;
+
+        ++block_count_;
+        block(block_count_ - 1) = fresh;
+    }
+
+    void release_front() {
+        if (spare_ == nullptr) {
+            spare_ = block(0);
+        } else {
+            memory_.deallocate(block(0), BlockSize);
+        }
+
+        map_head_ = (map_head_ + 1) & (map_capacity_ - 1);
+        --block_count_;
+    }
+
+    void grow_map() {
+        map_allocator map_memory(memory_);
+        size_t new_capacity = map_capacity_ == 0 ? 4 : map_capacity_ * 2;
+        pointer* new_map = map_memory.allocate(new_capacity);
+
+        for (size_t i = 0; i < block_count_; ++i) {
+            new_map[i] = block(i);
+        }
+        if (map_ != nullptr) {
+            map_memory.deallocate(map_, map_capacity_);
+        }
+
+        map_ = new_map;
+        map_capacity_ = new_capacity;
+        map_head_ = 0;
+    }
+
+    alloc memory_;
+    pointer* map_;
+    size_t map_capacity_;
+    size_t map_head_;
+    size_t block_count_;
+    pointer spare_;
+    size_t start_;
+    size_t size_;
+};
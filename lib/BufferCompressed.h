@@ -0,0 +1,250 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+template<typename T, size_t BlockSize = 256, typename alloc = std::allocator<T>>
+class BufferCompressed {
+    static_assert(std::is_integral_v<T>, "Compressed history requires an integral element type");
+    static_assert(BlockSize > 1, "Block must hold more than one element");
+
+    using byte_allocator = typename std::allocator_traits<alloc>::template rebind_alloc<uint8_t>;
+
+    struct Block {
+        T first;
+        std::vector<uint8_t, byte_allocator> bytes;
+    };
+
+public:
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using reference = T;
+        using pointer = void;
+
+        const_iterator() = default;
+
+        explicit const_iterator(const BufferCompressed* buffer, size_t index) : buffer_(buffer), index_(index) {
+            if (index_ < buffer_->size()) {
+                seek();
+            }
+        }
+
+        const_iterator& operator++() {
+            ++index_;
+            if (index_ >= buffer_->size()) {
+                return *this;
+            }
+
+            if (++offset_ == BlockSize) {
+                ++block_;
+                offset_ = 0;
+                start();
+            } else if (block_ < buffer_->blocks_.size()) {
+                delta_ += zigzag_decode(read_varint(buffer_->blocks_[block_].bytes.data(), position_));
+                value_ += delta_;
+            }
+            return *this;
+        }
+
+        reference operator*() const {
+            if (block_ == buffer_->blocks_.size()) {
+                return buffer_->open_[offset_];
+            }
+            return static_cast<T>(value_);
+        }
+
+        bool operator==(const const_iterator& x) const {
+            return index_ == x.index_;
+        }
+
+        bool operator!=(const const_iterator& x) const {
+            return !(*this == x);
+        }
+
+    private:
+        void seek() {
+            size_t absolute = index_ + buffer_->skip_;
+            block_ = absolute / BlockSize;
+            offset_ = 0;
+            start();
+
+            size_t target = absolute % BlockSize;
+            if (block_ == buffer_->blocks_.size()) {
+                offset_ = target;
+                return;
+            }
+
+            const uint8_t* bytes = buffer_->blocks_[block_].bytes.data();
+            for (; offset_ < target; ++offset_) {
+                delta_ += zigzag_decode(read_varint(bytes, position_));
+                value_ += delta_;
+            }
+        }
+
+        void start() {
+            position_ = 0;
+            delta_ = 0;
+            if (block_ < buffer_->blocks_.size()) {
+                value_ = static_cast<uint64_t>(buffer_->blocks_[block_].first);
+            }
+        }
+
+        const BufferCompressed* buffer_ = nullptr;
+        size_t index_ = 0;
+        size_t block_ = 0;
+        size_t offset_ = 0;
+        size_t position_ = 0;
+        uint64_t value_ = 0;
+        uint64_t delta_ = 0;
+    };
+
+    BufferCompressed() : open_size_(0), skip_(0), max_blocks_(0) {}
+
+    explicit BufferCompressed(const size_t max_blocks) : open_size_(0), skip_(0), max_blocks_(max_blocks) {}
+
+    void push(const T element) {
+        if (open_size_ == BlockSize) {
+            seal();
+        }
+
+        open_[open_size_++] = element;
+    }
+
+    void pop() {
+        if (empty()) {
+            throw ::std::invalid_argument("Buffer is empty");
+        }
+
+        ++skip_;
+        if (blocks_.empty()) {
+            if (skip_ == open_size_) {
+                open_size_ = 0;
+                skip_ = 0;
+            }
+        } else if (skip_ == BlockSize) {
+            blocks_.pop_front();
+            skip_ = 0;
+        }
+    }
+
+    void pop_block() {
+        if (empty()) {
+            throw ::std::invalid_argument("Buffer is empty");
+        }
+
+        if (blocks_.empty()) {
+            open_size_ = 0;
+        } else {
+            blocks_.pop_front();
+        }
+        skip_ = 0;
+    }
+
+    T operator[](const size_t n) const {
+        if (n >= size()) {
+            throw std::invalid_argument("Going beyond the boundaries of the container");
+        }
+
+        return *const_iterator(this, n);
+    }
+
+    const_iterator begin() const {
+        return const_iterator(this, 0);
+    }
+
+    const_iterator end() const {
+        return const_iterator(this, size());
+    }
+
+    void clear() {
+        blocks_.clear();
+        open_size_ = 0;
+        skip_ = 0;
+    }
+
+    size_t size() const {
+        return blocks_.size() * BlockSize + open_size_ - skip_;
+    }
+
+    size_t max_size() const {
+        return max_blocks_ == 0 ? 0 : (max_blocks_ + 1) * BlockSize;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    size_t memory_usage() const {
+        size_t bytes = sizeof(open_);
+        for (const Block& block: blocks_) {
+            bytes += sizeof(Block) + block.bytes.capacity();
+        }
+        return bytes;
+    }
+
+private:
+    void seal() {
+        if (max_blocks_ != 0 && blocks_.size() == max_blocks_) {
+            blocks_.pop_front();
+            skip_ = 0;
+        }
+
+        Block block{open_[0], {}};
+        block.bytes.reserve(BlockSize);
+
+        uint64_t previous = static_cast<uint64_t>(open_[0]);
+        uint64_t delta = 0;
+        for (size_t i = 1; i < BlockSize; ++i) {
+            uint64_t current = static_cast<uint64_t>(open_[i]);
+            uint64_t next_delta = current - previous;
+            write_varint(block.bytes, zigzag_encode(next_delta - delta));
+            delta = next_delta;
+            previous = current;
+        }
+        block.bytes.shrink_to_fit();
+
+        blocks_.push_back(std::move(block));
+        open_size_ = 0;
+    }
+
+    static uint64_t zigzag_encode(const uint64_t value) {
+        return (value << 1) ^ static_cast<uint64_t>(static_cast<int64_t>(value) >> 63);
+    }
+
+    static uint64_t zigzag_decode(const uint64_t value) {
+        return (value >> 1) ^ (~(value & 1) + 1);
+    }
+
+    static void write_varint(std::vector<uint8_t, byte_allocator>& bytes, uint64_t value) {
+        while (value >= 0x80) {
+            bytes.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        bytes.push_back(static_cast<uint8_t>(value));
+    }
+
+    static uint64_t read_varint(const uint8_t* bytes, size_t& position) {
+        uint64_t value = 0;
+        for (size_t shift = 0;; shift += 7) {
+            uint8_t byte = bytes[position++];
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (byte < 0x80) {
+                return value;
+            }
+        }
+    }
+
+    std::deque<Block> blocks_;
+    std::array<T, BlockSize> open_;
+    size_t open_size_;
+    size_t skip_;
+    size_t max_blocks_;
+};
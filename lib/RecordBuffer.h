@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <stdexcept>
+
+template<typename alloc = std::allocator<std::byte>>
+class RecordBuffer {
+    static constexpr size_t kAlignment = 8;
+    static constexpr size_t kHeaderSize = 8;
+    static constexpr uint32_t kPadding = UINT32_MAX;
+
+public:
+    explicit RecordBuffer(const size_t bytes, const bool overwrite = false) : capacity_(align(bytes)),
+                                                                              head_(0),
+                                                                              tail_(0),
+                                                                              count_(0),
+                                                                              evicted_(0),
+                                                                              overwrite_(overwrite) {
+        if (capacity_ == 0) {
+            throw ::std::invalid_argument("Buffer size not specified");
+        }
+
+        data_ = memory_.allocate(capacity_);
+    }
+
+    RecordBuffer(const RecordBuffer& x) = delete;
+
+    RecordBuffer& operator=(const RecordBuffer& x) = delete;
+
+    ~RecordBuffer() {
+        memory_.deallocate(data_, capacity_);
+    }
+
+    bool try_push(std::span<const std::byte> record) {
+        size_t need = kHeaderSize + align(record.size());
+        if (need > capacity_ || record.size() >= kPadding) {
+            return false;
+        }
+
+        size_t position = tail_ % capacity_;
+        size_t padding = capacity_ - position < need ? capacity_ - position : 0;
+
+        while (capacity_ - (tail_ - head_) < padding + need) {
+            if (!overwrite_) {
+                return false;
+            }
+
+            pop();
+            ++evicted_;
+
+            if (count_ == 0) {
+                position = 0;
+                padding = 0;
+            }
+        }
+
+        if (padding != 0) {
+            write_header(position, kPadding);
+            tail_ += padding;
+            position = 0;
+        }
+
+        write_header(position, static_cast<uint32_t>(record.size()));
+        if (!record.empty()) {
+            std::memcpy(data_ + position + kHeaderSize, record.data(), record.size());
+        }
+        tail_ += need;
+        ++count_;
+
+        return true;
+    }
+
+    std::span<const std::byte> peek() const {
+        if (count_ == 0) {
+            throw ::std::invalid_argument("Buffer is empty");
+        }
+
+        size_t position = front();
+        return {data_ + position + kHeaderSize, read_header(position)};
+    }
+
+    void pop() {
+        if (count_ == 0) {
+            throw ::std::invalid_argument("Buffer is empty");
+        }
+
+        size_t position = front();
+        size_t skipped = position == head_ % capacity_ ? 0 : capacity_ - head_ % capacity_;
+
+        head_ += skipped + kHeaderSize + align(read_header(position));
+
+        if (--count_ == 0) {
+            head_ = 0;
+            tail_ = 0;
+        }
+    }
+
+    void clear() {
+        head_ = 0;
+        tail_ = 0;
+        count_ = 0;
+    }
+
+    size_t size() const {
+        return count_;
+    }
+
+    size_t bytes_used() const {
+        return tail_ - head_;
+    }
+
+    size_t max_size() const {
+        return capacity_;
+    }
+
+    size_t evicted() const {
+        return evicted_;
+    }
+
+    bool empty() const {
+        return count_ == 0;
+    }
+
+private:
+    static size_t align(const size_t bytes) {
+        return (bytes + kAlignment - 1) & ~(kAlignment - 1);
+    }
+
+    size_t front() const {
+        size_t position = head_ % capacity_;
+        return read_header(position) == kPadding ? 0 : position;
+    }
+
+    uint32_t read_header(const size_t position) const {
+        uint32_t length;
+        std::memcpy(&length, data_ + position, sizeof(length));
+        return length;
+    }
+
+    void write_header(const size_t position, const uint32_t length) {
+        std::memcpy(data_ + position, &length, sizeof(length));
+    }
+
+    alloc memory_;
+    std::byte* data_;
+    size_t capacity_;
+    uint64_t head_;
+    uint64_t tail_;
+    size_t count_;
+    size_t evicted_;
+    bool overwrite_;
+};
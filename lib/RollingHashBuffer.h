@@ -0,0 +1,182 @@
+#pragma once
+
+#include <lib/Buffer.h>
+
+#include <array>
+#include <cstdint>
+#include <functional>
+
+constexpr std::array<uint64_t, 256> make_buzhash_table() {
+    std::array<uint64_t, 256> table{};
+    uint64_t state = 0x9e3779b97f4a7c15;
+    for (uint64_t& entry: table) {
+        state += 0x9e3779b97f4a7c15;
+        uint64_t z = state;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        entry = z ^ (z >> 31);
+    }
+    return table;
+}
+
+constexpr uint64_t modular_inverse(const uint64_t base) {
+    uint64_t x = base;
+    for (int i = 0; i < 6; ++i) {
+        x *= 2 - base * x;
+    }
+    return x;
+}
+
+class BuzHash {
+public:
+    void add(const uint8_t in) {
+        value_ = std::rotl(value_, 1) ^ kTable[in];
+        ++count_;
+    }
+
+    void remove(const uint8_t out) {
+        value_ ^= std::rotl(kTable[out], static_cast<int>((count_ - 1) & 63));
+        --count_;
+    }
+
+    uint64_t value() const {
+        return value_;
+    }
+
+    void reset() {
+        value_ = 0;
+        count_ = 0;
+    }
+
+private:
+    static constexpr std::array<uint64_t, 256> kTable = make_buzhash_table();
+
+    uint64_t value_ = 0;
+    size_t count_ = 0;
+};
+
+class RabinKarpHash {
+public:
+    void add(const uint8_t in) {
+        if (count_ != 0) {
+            power_ *= kBase;
+        }
+        value_ = value_ * kBase + in + 1;
+        ++count_;
+    }
+
+    void remove(const uint8_t out) {
+        value_ -= (out + 1) * power_;
+        if (--count_ != 0) {
+            power_ *= kInverse;
+        }
+    }
+
+    uint64_t value() const {
+        return value_;
+    }
+
+    void reset() {
+        value_ = 0;
+        power_ = 1;
+        count_ = 0;
+    }
+
+private:
+    static constexpr uint64_t kBase = 0x100000001b3;
+    static constexpr uint64_t kInverse = modular_inverse(kBase);
+
+    uint64_t value_ = 0;
+    uint64_t power_ = 1;
+    size_t count_ = 0;
+};
+
+template<typename T, typename Hasher = BuzHash, typename alloc = std::allocator<T>>
+class RollingHashBuffer {
+    static_assert(sizeof(T) == 1, "Rolling hash requires a byte-sized element type");
+
+public:
+    using const_reverence = const T&;
+    using boundary_callback = std::function<void(size_t, uint64_t)>;
+
+    explicit RollingHashBuffer(const size_t size) : buffer_(size) {}
+
+    void push(const_reverence element) {
+        push_one(element);
+    }
+
+    template<typename InputIt>
+    void push_range(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            push_one(*first);
+        }
+    }
+
+    void pop() {
+        if (!buffer_.empty()) {
+            hasher_.remove(static_cast<uint8_t>(*buffer_.begin()));
+        }
+        buffer_.pop();
+    }
+
+    void clear() {
+        while (!buffer_.empty()) {
+            buffer_.pop();
+        }
+        hasher_.reset();
+    }
+
+    T operator[](const size_t n) {
+        return buffer_[n];
+    }
+
+    std::pair<std::span<const T>, std::span<const T>> segments() {
+        auto [first, second] = buffer_.segments();
+        return {first, second};
+    }
+
+    uint64_t hash() const {
+        return hasher_.value();
+    }
+
+    void set_boundary(const uint64_t mask, boundary_callback callback) {
+        mask_ = mask;
+        callback_ = std::move(callback);
+    }
+
+    size_t size() {
+        return buffer_.size();
+    }
+
+    size_t max_size() {
+        return buffer_.max_size();
+    }
+
+    bool empty() {
+        return buffer_.empty();
+    }
+
+private:
+    void push_one(const_reverence element) {
+        bool evicts = !buffer_.empty() && buffer_.size() == buffer_.max_size();
+        uint8_t evicted = evicts ? static_cast<uint8_t>(*buffer_.begin()) : 0;
+
+        buffer_.push(element);
+
+        if (evicts) {
+            hasher_.remove(evicted);
+        }
+        hasher_.add(static_cast<uint8_t>(element));
+        ++offset_;
+
+        if (callback_ && buffer_.size() == buffer_.max_size() && (hasher_.value() & mask_) == 0) {
+            callback_(offset_, hasher_.value());
+        }
+    }
+
+    BufferStatic<T, alloc> buffer_;
+    Hasher hasher_;
+    uint64_t mask_ = 0;
+    boundary_callback callback_;
+    size_t offset_ = 0;
+};
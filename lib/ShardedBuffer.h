@@ -0,0 +1,184 @@
+#pragma once
+
+#include <lib/Buffer.h>
+
+#include <atomic>
+#include <queue>
+#include <thread>
+#include <vector>
+
+template<typename T, typename alloc = std::allocator<T>>
+class ShardedBuffer {
+public:
+    using const_reference = const T&;
+
+    explicit ShardedBuffer(const size_t shards, const size_t shard_size) {
+        if (shards == 0) {
+            throw ::std::invalid_argument("Shard count not specified");
+        }
+
+        for (size_t i = 0; i < shards; ++i) {
+            shards_.push_back(std::make_unique<Shard>(shard_size));
+        }
+    }
+
+    ShardedBuffer(const ShardedBuffer& x) = delete;
+
+    ShardedBuffer& operator=(const ShardedBuffer& x) = delete;
+
+    void push(const size_t shard, const_reference element) {
+        Shard& target = at(shard);
+        Guard guard(target.lock);
+
+        bool full = target.buffer.size() == target.buffer.max_size();
+        target.buffer.push(element);
+
+        if (full) {
+            ++target.overwritten;
+        }
+    }
+
+    template<typename Consumer>
+    size_t drain(Consumer consumer) {
+        std::vector<std::vector<T>> batches = collect();
+
+        size_t total = 0;
+        for (size_t index = 0;; ++index) {
+            size_t emitted = 0;
+            for (std::vector<T>& batch: batches) {
+                if (index < batch.size()) {
+                    consumer(batch[index]);
+                    ++emitted;
+                }
+            }
+            if (emitted == 0) {
+                return total;
+            }
+            total += emitted;
+        }
+    }
+
+    template<typename KeyOf, typename Consumer>
+    size_t drain_ordered(KeyOf key_of, Consumer consumer) {
+        std::vector<std::vector<T>> batches = collect();
+        std::vector<size_t> positions(batches.size(), 0);
+
+        auto later = [&](size_t lhs, size_t rhs) {
+            return key_of(batches[rhs][positions[rhs]]) < key_of(batches[lhs][positions[lhs]]);
+        };
+        std::priority_queue<size_t, std::vector<size_t>, decltype(later)> heads(later);
+
+        for (size_t i = 0; i < batches.size(); ++i) {
+            if (!batches[i].empty()) {
+                heads.push(i);
+            }
+        }
+
+        size_t total = 0;
+        while (!heads.empty()) {
+            size_t shard = heads.top();
+            heads.pop();
+
+            consumer(batches[shard][positions[shard]]);
+            ++total;
+
+            if (++positions[shard] < batches[shard].size()) {
+                heads.push(shard);
+            }
+        }
+        return total;
+    }
+
+    size_t size(const size_t shard) {
+        Shard& target = at(shard);
+        Guard guard(target.lock);
+        return target.buffer.size();
+    }
+
+    size_t size() {
+        size_t total = 0;
+        for (size_t i = 0; i < shards_.size(); ++i) {
+            total += size(i);
+        }
+        return total;
+    }
+
+    size_t overwritten(const size_t shard) {
+        Shard& target = at(shard);
+        Guard guard(target.lock);
+        return target.overwritten;
+    }
+
+    size_t overwritten() {
+        size_t total = 0;
+        for (size_t i = 0; i < shards_.size(); ++i) {
+            total += overwritten(i);
+        }
+        return total;
+    }
+
+    size_t max_size() {
+        return shards_.size() * shards_.front()->capacity;
+    }
+
+    size_t shard_count() {
+        return shards_.size();
+    }
+
+private:
+    struct alignas(64) Shard {
+        explicit Shard(const size_t size) : buffer(size), spare(size), capacity(size) {}
+
+        std::atomic_flag lock;
+        BufferStatic<T, alloc> buffer;
+        BufferStatic<T, alloc> spare;
+        const size_t capacity;
+        size_t overwritten = 0;
+    };
+
+    class Guard {
+    public:
+        explicit Guard(std::atomic_flag& lock) : lock_(lock) {
+            while (lock_.test_and_set(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+        }
+
+        ~Guard() {
+            lock_.clear(std::memory_order_release);
+        }
+
+    private:
+        std::atomic_flag& lock_;
+    };
+
+    Shard& at(const size_t shard) {
+        if (shard >= shards_.size()) {
+            throw std::invalid_argument("Going beyond the boundaries of the container");
+        }
+        return *shards_[shard];
+    }
+
+    std::vector<std::vector<T>> collect() {
+        std::vector<std::vector<T>> batches(shards_.size());
+        Guard drain_guard(drain_lock_);
+
+        for (size_t i = 0; i < shards_.size(); ++i) {
+            Shard& shard = *shards_[i];
+            {
+                Guard guard(shard.lock);
+                shard.buffer.swap(shard.spare);
+            }
+
+            batches[i].reserve(shard.spare.size());
+            while (!shard.spare.empty()) {
+                batches[i].push_back(*shard.spare.begin());
+                shard.spare.pop();
+            }
+        }
+        return batches;
+    }
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::atomic_flag drain_lock_;
+};
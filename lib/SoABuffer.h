@@ -0,0 +1,261 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+template<typename... Fields>
+class SoABuffer;
+
+template<typename... Fields>
+class SoAIterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::tuple<Fields...>;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::tuple<Fields&...>;
+    using pointer = void;
+
+    SoAIterator() = default;
+
+    explicit SoAIterator(SoABuffer<Fields...>* buffer, size_t index) : buffer_(buffer), index_(index) {}
+
+    SoAIterator& operator++() {
+        ++index_;
+        return *this;
+    }
+
+    SoAIterator& operator--() {
+        --index_;
+        return *this;
+    }
+
+    SoAIterator operator+(const size_t n) const {
+        return SoAIterator(buffer_, index_ + n);
+    }
+
+    SoAIterator operator-(const size_t n) const {
+        return SoAIterator(buffer_, index_ - n);
+    }
+
+    SoAIterator& operator+=(const int64_t n) {
+        index_ += n;
+        return *this;
+    }
+
+    size_t operator-(const SoAIterator& x) const {
+        return index_ - x.index_;
+    }
+
+    reference operator*() const {
+        return (*buffer_)[index_];
+    }
+
+    reference operator[](const size_t n) const {
+        return (*buffer_)[index_ + n];
+    }
+
+    bool operator==(const SoAIterator& x) const {
+        return index_ == x.index_;
+    }
+
+    bool operator!=(const SoAIterator& x) const {
+        return !(*this == x);
+    }
+
+    bool operator<(const SoAIterator& x) const {
+        return index_ < x.index_;
+    }
+
+    bool operator>(const SoAIterator& x) const {
+        return x.index_ < index_;
+    }
+
+    bool operator<=(const SoAIterator& x) const {
+        return index_ <= x.index_;
+    }
+
+    bool operator>=(const SoAIterator& x) const {
+        return index_ >= x.index_;
+    }
+
+private:
+    SoABuffer<Fields...>* buffer_ = nullptr;
+    size_t index_ = 0;
+};
+
+template<typename... Fields>
+class SoABuffer {
+public:
+    using value_type = std::tuple<Fields...>;
+    using reference = std::tuple<Fields&...>;
+    using iterator = SoAIterator<Fields...>;
+
+    template<size_t I>
+    using field_type = std::tuple_element_t<I, value_type>;
+
+    SoABuffer() : capacity_(0), head_(0), size_(0) {}
+
+    explicit SoABuffer(const size_t size) : capacity_(size), head_(0), size_(0) {
+        allocate(std::index_sequence_for<Fields...>{});
+    }
+
+    SoABuffer(const SoABuffer& x) : capacity_(x.capacity_), head_(0), size_(0) {
+        allocate(std::index_sequence_for<Fields...>{});
+        try {
+            for (size_t i = 0; i < x.size_; ++i) {
+                std::apply([this](const Fields&... fields) { push(fields...); }, value_type(x.at(i)));
+            }
+        } catch (...) {
+            deallocate(std::index_sequence_for<Fields...>{});
+            throw;
+        }
+    }
+
+    SoABuffer& operator=(const SoABuffer& x) {
+        if (this == &x) {
+            return *this;
+        }
+
+        SoABuffer copy(x);
+        swap(copy);
+        return *this;
+    }
+
+    ~SoABuffer() {
+        deallocate(std::index_sequence_for<Fields...>{});
+    }
+
+    void push(const Fields&... fields) {
+        if (capacity_ == 0) {
+            throw ::std::invalid_argument("Buffer size not specified");
+        }
+
+        size_t slot = index(size_);
+        if (size_ == capacity_) {
+            head_ = index(1);
+        } else {
+            ++size_;
+        }
+
+        store(slot, std::index_sequence_for<Fields...>{}, fields...);
+    }
+
+    void pop() {
+        if (size_ == 0) {
+            throw ::std::invalid_argument("Buffer is empty");
+        }
+
+        head_ = index(1);
+        --size_;
+    }
+
+    reference operator[](const size_t n) {
+        if (n >= size_) {
+            throw std::invalid_argument("Going beyond the boundaries of the container");
+        }
+
+        return at(n);
+    }
+
+    template<size_t I>
+    field_type<I>& get(const size_t n) {
+        if (n >= size_) {
+            throw std::invalid_argument("Going beyond the boundaries of the container");
+        }
+
+        return std::get<I>(columns_)[index(n)];
+    }
+
+    template<size_t I>
+    std::pair<std::span<field_type<I>>, std::span<field_type<I>>> segments() {
+        field_type<I>* column = std::get<I>(columns_);
+        size_t first = std::min(size_, capacity_ - head_);
+
+        return {std::span<field_type<I>>(column + head_, first), std::span<field_type<I>>(column, size_ - first)};
+    }
+
+    iterator begin() {
+        return iterator(this, 0);
+    }
+
+    iterator end() {
+        return iterator(this, size_);
+    }
+
+    void swap(SoABuffer& x) {
+        std::swap(columns_, x.columns_);
+        std::swap(capacity_, x.capacity_);
+        std::swap(head_, x.head_);
+        std::swap(size_, x.size_);
+    }
+
+    void clear() {
+        head_ = 0;
+        size_ = 0;
+    }
+
+    size_t size() {
+        return size_;
+    }
+
+    size_t max_size() {
+        return capacity_;
+    }
+
+    bool empty() {
+        return size_ == 0;
+    }
+
+private:
+    size_t index(const size_t n) const {
+        size_t slot = head_ + n;
+        return slot >= capacity_ ? slot - capacity_ : slot;
+    }
+
+    reference at(const size_t n) const {
+        size_t slot = index(n);
+        return std::apply([slot](Fields*... columns) { return reference(columns[slot]...); }, columns_);
+    }
+
+    template<size_t... I>
+    void store(const size_t slot, std::index_sequence<I...>, const Fields&... fields) {
+        ((std::get<I>(columns_)[slot] = fields), ...);
+    }
+
+    template<size_t... I>
+    void allocate(std::index_sequence<I...>) {
+        if (capacity_ == 0) {
+            return;
+        }
+
+        size_t allocated = 0;
+        size_t constructed = 0;
+        try {
+            ((std::get<I>(columns_) = std::allocator<Fields>().allocate(capacity_), ++allocated), ...);
+            ((std::uninitialized_value_construct_n(std::get<I>(columns_), capacity_), ++constructed), ...);
+        } catch (...) {
+            ((I < constructed ? (void) std::destroy_n(std::get<I>(columns_), capacity_) : void()), ...);
+            ((I < allocated ? std::allocator<Fields>().deallocate(std::get<I>(columns_), capacity_) : void()), ...);
+            throw;
+        }
+    }
+
+    template<size_t... I>
+    void deallocate(std::index_sequence<I...>) {
+        if (capacity_ == 0) {
+            return;
+        }
+
+        ((std::destroy_n(std::get<I>(columns_), capacity_)), ...);
+        ((std::allocator<Fields>().deallocate(std::get<I>(columns_), capacity_)), ...);
+    }
+
+    std::tuple<Fields*...> columns_{};
+    size_t capacity_;
+    size_t head_;
+    size_t size_;
+};
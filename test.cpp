@@ -1,6 +1,17 @@
 #include <lib/Buffer.h>
+#include <lib/SoABuffer.h>
+#include <lib/BufferCompressed.h>
+#include <lib/BufferChunked.h>
+#include <lib/RollingHashBuffer.h>
+#include <lib/ShardedBuffer.h>
+#include <lib/BroadcastBuffer.h>
+#include <lib/RecordBuffer.h>
 #include <gtest/gtest.h>
 
+#if BUFFER_HAS_FD_IO
+#include <unistd.h>
+#endif
+
 TEST(BufferTestSuite, CreateManyTypesStaticTest) {
     BufferStatic<int> buffer_int(15);
     BufferStatic<bool> buffer_bool(15);
@@ -376,3 +387,1008 @@ TEST(BufferTestSuite, FindBuffer) {
 
     ASSERT_EQ(*it, 4);
 }
+
+
+TEST(BufferTestSuite, SegmentsStaticTest) {
+    BufferStatic<int> buffer(4);
+    for (int i = 0; i < 6; ++i) {
+        buffer.push(i);
+    }
+
+    auto [first, second] = buffer.segments();
+    ASSERT_EQ(first.size() + second.size(), 4);
+
+    int i = 2;
+    for (int elem: first) {
+        ASSERT_EQ(elem, i++);
+    }
+    for (int elem: second) {
+        ASSERT_EQ(elem, i++);
+    }
+}
+
+#if BUFFER_HAS_FD_IO
+TEST(BufferTestSuite, ReadFromFdStaticTest) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    ASSERT_EQ(write(fds[1], "abcdef", 6), 6);
+
+    BufferStatic<char> buffer(8);
+    ASSERT_EQ(buffer.read_from(fds[0], 4), 4);
+    ASSERT_EQ(buffer.size(), 4);
+    buffer.pop();
+    buffer.pop();
+    buffer.pop();
+
+    ASSERT_EQ(write(fds[1], "ghijklm", 7), 7);
+    ASSERT_EQ(buffer.read_from(fds[0], 100), 7);
+    ASSERT_EQ(buffer.size(), 8);
+
+    std::string expected = "defghijk";
+    for (int i = 0; i < 8; ++i) {
+        ASSERT_EQ(buffer[i], expected[i]);
+    }
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+TEST(BufferTestSuite, WriteToFdStaticTest) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+
+    BufferStatic<char> buffer(4);
+    for (char c: std::string("abcdef")) {
+        buffer.push(c);
+    }
+
+    ASSERT_EQ(buffer.write_to(fds[1], 3), 3);
+    ASSERT_EQ(buffer.size(), 1);
+    ASSERT_EQ(buffer.write_to(fds[1], 3), 1);
+    ASSERT_TRUE(buffer.empty());
+    ASSERT_THROW(buffer.write_to(fds[1], 3), std::invalid_argument);
+
+    char result[4];
+    ASSERT_EQ(read(fds[0], result, 4), 4);
+    ASSERT_EQ(std::string(result, 4), "cdef");
+
+    close(fds[0]);
+    close(fds[1]);
+}
+#endif
+
+TEST(BufferTestSuite, SoAPushTest) {
+    SoABuffer<int64_t, double, int> buffer(3);
+    for (int i = 0; i < 5; ++i) {
+        buffer.push(i, i * 0.5, i * 10);
+    }
+
+    ASSERT_EQ(buffer.size(), 3);
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_EQ(buffer.get<0>(i), i + 2);
+        ASSERT_EQ(std::get<1>(buffer[i]), (i + 2) * 0.5);
+        ASSERT_EQ(std::get<2>(buffer[i]), (i + 2) * 10);
+    }
+
+    buffer.pop();
+    ASSERT_EQ(buffer.get<0>(0), 3);
+}
+
+TEST(BufferTestSuite, SoASegmentsTest) {
+    SoABuffer<int64_t, int> buffer(4);
+    for (int i = 0; i < 6; ++i) {
+        buffer.push(i, i * 2);
+    }
+
+    auto [first, second] = buffer.segments<1>();
+    ASSERT_EQ(first.size() + second.size(), 4);
+
+    int i = 2;
+    for (int elem: first) {
+        ASSERT_EQ(elem, 2 * i++);
+    }
+    for (int elem: second) {
+        ASSERT_EQ(elem, 2 * i++);
+    }
+}
+
+TEST(BufferTestSuite, SoAIteratorTest) {
+    SoABuffer<int, char> buffer(3);
+    buffer.push(1, 'a');
+    buffer.push(2, 'b');
+    buffer.push(3, 'c');
+    buffer.push(4, 'd');
+
+    int i = 2;
+    for (SoABuffer<int, char>::iterator it = buffer.begin(); it != buffer.end(); ++it, ++i) {
+        auto [number, letter] = *it;
+        ASSERT_EQ(number, i);
+        ASSERT_EQ(letter, 'a' + i - 1);
+        letter = 'z';
+    }
+
+    ASSERT_EQ(std::get<1>(buffer[0]), 'z');
+    ASSERT_EQ(buffer.end() - buffer.begin(), 3);
+
+    SoABuffer<int, char> copy(buffer);
+    ASSERT_EQ(copy.get<0>(2), 4);
+}
+
+TEST(BufferTestSuite, SoACopyEmptyTest) {
+    SoABuffer<int, double> buffer;
+    SoABuffer<int, double> copy(buffer);
+
+    ASSERT_EQ(copy.max_size(), 0);
+    ASSERT_TRUE(copy.empty());
+    ASSERT_THROW(copy.push(1, 1.0), std::invalid_argument);
+}
+
+struct ThrowingField {
+    ThrowingField() {
+        if (++constructed == 3) {
+            throw std::runtime_error("construction failed");
+        }
+    }
+
+    static inline int constructed = 0;
+};
+
+TEST(BufferTestSuite, SoAAllocationFailureTest) {
+    ThrowingField::constructed = 0;
+    ASSERT_THROW((SoABuffer<std::string, ThrowingField>(4)), std::runtime_error);
+}
+
+TEST(BufferTestSuite, BoolStaticPushTest) {
+    BufferStatic<bool> buffer(70);
+    for (int i = 0; i < 100; ++i) {
+        buffer.push(i % 3 == 0);
+    }
+
+    ASSERT_EQ(buffer.size(), 70);
+    for (int i = 0; i < 70; ++i) {
+        ASSERT_EQ(buffer[i], (i + 30) % 3 == 0);
+    }
+
+    buffer[0] = false;
+    ASSERT_FALSE(buffer[0]);
+
+    size_t expected = 0;
+    for (bool flag: buffer) {
+        expected += flag;
+    }
+    ASSERT_EQ(buffer.count(), expected);
+}
+
+TEST(BufferTestSuite, BoolStaticBulkPushTest) {
+    BufferStatic<bool> buffer(100);
+    for (int i = 0; i < 5; ++i) {
+        buffer.push_bits(~uint64_t(0), 64);
+    }
+    ASSERT_EQ(buffer.size(), 100);
+    ASSERT_TRUE(buffer.all());
+
+    buffer.push_bits(0b1010, 4);
+    ASSERT_EQ(buffer.count(), 98);
+    ASSERT_FALSE(buffer[96]);
+    ASSERT_TRUE(buffer[97]);
+    ASSERT_FALSE(buffer[98]);
+    ASSERT_TRUE(buffer[99]);
+
+    buffer.clear();
+    ASSERT_FALSE(buffer.any());
+}
+
+TEST(BufferTestSuite, CompressedPushTest) {
+    BufferCompressed<int64_t, 64> buffer;
+    std::vector<int64_t> expected;
+    int64_t timestamp = 1700000000000;
+    for (int i = 0; i < 10000; ++i) {
+        timestamp += 1000 + (i % 7) - 3;
+        buffer.push(timestamp);
+        expected.push_back(timestamp);
+    }
+
+    ASSERT_EQ(buffer.size(), 10000);
+    ASSERT_LT(buffer.memory_usage() * 4, expected.size() * sizeof(int64_t));
+
+    size_t i = 0;
+    for (int64_t elem: buffer) {
+        ASSERT_EQ(elem, expected[i++]);
+    }
+    ASSERT_EQ(i, expected.size());
+
+    ASSERT_EQ(buffer[0], expected[0]);
+    ASSERT_EQ(buffer[4321], expected[4321]);
+    ASSERT_EQ(buffer[9999], expected[9999]);
+}
+
+TEST(BufferTestSuite, CompressedEvictionTest) {
+    BufferCompressed<int32_t, 4> buffer(2);
+    for (int i = 0; i < 15; ++i) {
+        buffer.push(i * i - 50);
+    }
+
+    ASSERT_EQ(buffer.size(), 11);
+    ASSERT_EQ(buffer.max_size(), 12);
+    for (int i = 0; i < 11; ++i) {
+        ASSERT_EQ(buffer[i], (i + 4) * (i + 4) - 50);
+    }
+
+    buffer.pop();
+    buffer.pop();
+    ASSERT_EQ(buffer[0], 6 * 6 - 50);
+    buffer.pop_block();
+    ASSERT_EQ(buffer.size(), 7);
+    ASSERT_EQ(*buffer.begin(), 8 * 8 - 50);
+}
+
+TEST(BufferTestSuite, ChunkedPushTest) {
+    BufferChunked<int, 8> buffer;
+    buffer.push(0);
+    int* first = &buffer[0];
+
+    for (int i = 1; i < 100; ++i) {
+        buffer.push(i);
+    }
+
+    ASSERT_EQ(first, &buffer[0]);
+    ASSERT_EQ(buffer.size(), 100);
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(buffer[i], i);
+    }
+}
+
+TEST(BufferTestSuite, ChunkedPushAndPopTest) {
+    BufferChunked<std::string, 4> buffer;
+    for (int i = 0; i < 10; ++i) {
+        buffer.push(std::to_string(i));
+    }
+    std::string* last = &buffer[9];
+
+    for (int i = 0; i < 7; ++i) {
+        buffer.pop();
+    }
+    for (int i = 10; i < 30; ++i) {
+        buffer.push(std::to_string(i));
+    }
+
+    ASSERT_EQ(last, &buffer[2]);
+    ASSERT_EQ(buffer.size(), 23);
+
+    int i = 7;
+    for (BufferChunked<std::string, 4>::iterator it = buffer.begin(); it != buffer.end(); ++it, ++i) {
+        ASSERT_EQ(*it, std::to_string(i));
+    }
+
+    BufferChunked<std::string, 4> copy(buffer);
+    buffer.clear();
+    ASSERT_TRUE(buffer.empty());
+    ASSERT_EQ(copy[22], "29");
+}
+
+TEST(BufferTestSuite, ShrinkToFitDinamicTest) {
+    BufferDynamic<int> buffer;
+    for (int i = 0; i < 100; ++i) {
+        buffer.push(i);
+    }
+    for (int i = 0; i < 90; ++i) {
+        buffer.pop();
+    }
+
+    ASSERT_EQ(buffer.max_size(), 128);
+    buffer.shrink_to_fit();
+    ASSERT_EQ(buffer.max_size(), 10);
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_EQ(buffer[i], i + 90);
+    }
+
+    buffer.clear();
+    buffer.shrink_to_fit();
+    ASSERT_EQ(buffer.max_size(), 0);
+    buffer.push(1);
+    ASSERT_EQ(buffer[0], 1);
+}
+
+TEST(BufferTestSuite, AutoShrinkDinamicTest) {
+    BufferDynamic<int> buffer;
+    buffer.set_auto_shrink(true);
+    for (int i = 0; i < 1000; ++i) {
+        buffer.push(i);
+    }
+    ASSERT_EQ(buffer.max_size(), 1024);
+
+    for (int i = 0; i < 990; ++i) {
+        buffer.pop();
+    }
+    ASSERT_LE(buffer.max_size(), 40);
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_EQ(buffer[i], i + 990);
+    }
+
+    buffer.clear();
+    ASSERT_EQ(buffer.max_size(), 0);
+}
+
+TEST(BufferTestSuite, BoundedGrowthDinamicTest) {
+    BufferDynamic<int> buffer;
+    buffer.set_max_capacity(6);
+    for (int i = 0; i < 20; ++i) {
+        buffer.push(i);
+    }
+
+    ASSERT_EQ(buffer.size(), 6);
+    ASSERT_EQ(buffer.max_size(), 6);
+    for (int i = 0; i < 6; ++i) {
+        ASSERT_EQ(buffer[i], i + 14);
+    }
+
+    buffer.set_max_capacity(3);
+    ASSERT_EQ(buffer.max_size(), 3);
+    ASSERT_EQ(buffer[0], 17);
+}
+
+template<typename Hasher>
+uint64_t WindowHash(const std::string& window) {
+    Hasher hasher;
+    for (char c: window) {
+        hasher.add(static_cast<uint8_t>(c));
+    }
+    return hasher.value();
+}
+
+TEST(BufferTestSuite, RollingHashBuzTest) {
+    std::string data = "the quick brown fox jumps over the lazy dog";
+    RollingHashBuffer<char, BuzHash> buffer(8);
+    buffer.push_range(data.begin(), data.end());
+
+    ASSERT_EQ(buffer.hash(), WindowHash<BuzHash>(data.substr(data.size() - 8)));
+
+    buffer.pop();
+    buffer.pop();
+    ASSERT_EQ(buffer.hash(), WindowHash<BuzHash>(data.substr(data.size() - 6)));
+}
+
+TEST(BufferTestSuite, RollingHashClearTest) {
+    RollingHashBuffer<char> buffer(4);
+    std::string data = "abcdefgh";
+    buffer.push_range(data.begin(), data.end());
+
+    auto [first, second] = buffer.segments();
+    ASSERT_EQ(std::string(first.begin(), first.end()) + std::string(second.begin(), second.end()), "efgh");
+    ASSERT_EQ(buffer[0], 'e');
+
+    buffer.clear();
+    ASSERT_TRUE(buffer.empty());
+    ASSERT_EQ(buffer.hash(), 0);
+
+    buffer.push_range(data.begin(), data.begin() + 3);
+    ASSERT_EQ(buffer.hash(), WindowHash<BuzHash>("abc"));
+}
+
+TEST(BufferTestSuite, RollingHashRabinKarpTest) {
+    std::string data = "the quick brown fox jumps over the lazy dog";
+    RollingHashBuffer<char, RabinKarpHash> buffer(5);
+    for (char c: data) {
+        buffer.push(c);
+    }
+
+    ASSERT_EQ(buffer.hash(), WindowHash<RabinKarpHash>(data.substr(data.size() - 5)));
+
+    buffer.pop();
+    ASSERT_EQ(buffer.hash(), WindowHash<RabinKarpHash>(data.substr(data.size() - 4)));
+}
+
+TEST(BufferTestSuite, RollingHashBoundaryTest) {
+    std::string data;
+    for (int i = 0; i < 4096; ++i) {
+        data.push_back(static_cast<char>((i * 7919) % 251));
+    }
+
+    std::vector<size_t> boundaries;
+    RollingHashBuffer<char> buffer(16);
+    buffer.set_boundary(0x3f, [&boundaries](size_t offset, uint64_t hash) {
+        ASSERT_EQ(hash & 0x3f, 0);
+        boundaries.push_back(offset);
+    });
+    buffer.push_range(data.begin(), data.end());
+
+    ASSERT_FALSE(boundaries.empty());
+    for (size_t offset: boundaries) {
+        ASSERT_EQ(WindowHash<BuzHash>(data.substr(offset - 16, 16)) & 0x3f, 0);
+    }
+}
+
+TEST(BufferTestSuite, SnapshotDinamicTest) {
+    BufferDynamic<int> buffer;
+    for (int i = 0; i < 8; ++i) {
+        buffer.push(i);
+    }
+
+    BufferSnapshot<int> snapshot = buffer.snapshot();
+    for (int i = 8; i < 100; ++i) {
+        buffer.push(i);
+    }
+
+    ASSERT_EQ(snapshot.size(), 8);
+    int i = 0;
+    for (BufferSnapshot<int>::iterator it = snapshot.begin(); it != snapshot.end(); ++it, ++i) {
+        ASSERT_EQ(*it, i);
+    }
+    ASSERT_EQ(buffer[99], 99);
+}
+
+TEST(BufferTestSuite, SnapshotCopyOnWriteDinamicTest) {
+    BufferDynamic<int> buffer(8);
+    for (int i = 0; i < 6; ++i) {
+        buffer.push(i);
+    }
+
+    BufferSnapshot<int> snapshot = buffer.snapshot();
+    for (int i = 0; i < 4; ++i) {
+        buffer.pop();
+    }
+    buffer.push(6);
+    buffer.push(7);
+
+    buffer.push(8);
+    buffer.push(9);
+    buffer.push(10);
+
+    for (int i = 0; i < 6; ++i) {
+        ASSERT_EQ(snapshot[i], i);
+    }
+    for (int i = 0; i < 7; ++i) {
+        ASSERT_EQ(buffer[i], i + 4);
+    }
+}
+
+TEST(BufferTestSuite, SnapshotBoundedDinamicTest) {
+    BufferDynamic<int> buffer;
+    buffer.set_max_capacity(4);
+    for (int i = 0; i < 4; ++i) {
+        buffer.push(i);
+    }
+
+    BufferSnapshot<int> snapshot = buffer.snapshot();
+    for (int i = 4; i < 10; ++i) {
+        buffer.push(i);
+    }
+
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_EQ(snapshot[i], i);
+        ASSERT_EQ(buffer[i], i + 6);
+    }
+}
+
+#if BUFFER_HAS_FD_IO
+TEST(BufferTestSuite, SnapshotReadFromDinamicTest) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    ASSERT_EQ(write(fds[1], "XYZXYZXY", 8), 8);
+
+    BufferDynamic<char> buffer(8);
+    for (char c: std::string("abcdef")) {
+        buffer.push(c);
+    }
+
+    BufferSnapshot<char> snapshot = buffer.snapshot();
+    for (int i = 0; i < 6; ++i) {
+        buffer.pop();
+    }
+    ASSERT_EQ(buffer.read_from(fds[0], 8), 8);
+
+    ASSERT_EQ(std::string(snapshot.begin(), snapshot.end()), "abcdef");
+    for (int i = 0; i < 8; ++i) {
+        ASSERT_EQ(buffer[i], "XYZXYZXY"[i]);
+    }
+
+    close(fds[0]);
+    close(fds[1]);
+}
+#endif
+
+TEST(BufferTestSuite, AssignmentReleasesDinamicTest) {
+    BufferDynamic<int> buffer_1 = {1, 2, 3};
+    BufferDynamic<int> buffer_2 = {4, 5};
+    buffer_1 = buffer_2;
+    buffer_1 = buffer_1;
+
+    ASSERT_TRUE(buffer_1 == buffer_2);
+}
+
+TEST(BufferTestSuite, CopyKeepsLimitsDinamicTest) {
+    BufferDynamic<int> buffer;
+    buffer.set_max_capacity(4);
+    buffer.set_auto_shrink(true);
+
+    BufferDynamic<int> copy(buffer);
+    BufferDynamic<int> assigned;
+    assigned = buffer;
+    for (int i = 0; i < 10; ++i) {
+        copy.push(i);
+        assigned.push(i);
+    }
+
+    ASSERT_EQ(copy.max_capacity(), 4);
+    ASSERT_EQ(copy.size(), 4);
+    ASSERT_EQ(copy[0], 6);
+    ASSERT_EQ(assigned.size(), 4);
+    ASSERT_TRUE(copy == assigned);
+}
+
+TEST(BufferTestSuite, ShardedOrderedDrainTest) {
+    ShardedBuffer<std::pair<int, int>> buffer(4, 1000);
+
+    std::vector<std::thread> producers;
+    for (int shard = 0; shard < 4; ++shard) {
+        producers.emplace_back([&buffer, shard]() {
+            for (int i = 0; i < 1000; ++i) {
+                buffer.push(shard, {i * 4 + shard, shard});
+            }
+        });
+    }
+    for (std::thread& producer: producers) {
+        producer.join();
+    }
+
+    ASSERT_EQ(buffer.size(), 4000);
+    ASSERT_EQ(buffer.overwritten(), 0);
+
+    int expected = 0;
+    size_t drained = buffer.drain_ordered([](const std::pair<int, int>& x) { return x.first; },
+                                          [&expected](const std::pair<int, int>& x) {
+                                              ASSERT_EQ(x.first, expected++);
+                                          });
+    ASSERT_EQ(drained, 4000);
+    ASSERT_EQ(buffer.size(), 0);
+}
+
+TEST(BufferTestSuite, ShardedRoundRobinDrainTest) {
+    ShardedBuffer<int> buffer(3, 4);
+    for (int i = 0; i < 6; ++i) {
+        buffer.push(0, i);
+    }
+    buffer.push(1, 100);
+    buffer.push(2, 200);
+    buffer.push(2, 201);
+
+    ASSERT_EQ(buffer.overwritten(0), 2);
+    ASSERT_EQ(buffer.overwritten(), 2);
+    ASSERT_EQ(buffer.size(0), 4);
+    ASSERT_EQ(buffer.max_size(), 12);
+
+    std::vector<int> drained;
+    buffer.drain([&drained](int x) { drained.push_back(x); });
+    ASSERT_EQ(drained, std::vector<int>({2, 100, 200, 3, 201, 4, 5}));
+}
+
+TEST(BufferTestSuite, ShardedDrainRefillTest) {
+    ShardedBuffer<int> buffer(2, 3);
+    for (int i = 0; i < 4; ++i) {
+        buffer.push(0, i);
+    }
+
+    std::vector<int> drained;
+    ASSERT_EQ(buffer.drain([&drained](int x) { drained.push_back(x); }), 3);
+    ASSERT_EQ(drained, std::vector<int>({1, 2, 3}));
+    ASSERT_EQ(buffer.size(), 0);
+    ASSERT_EQ(buffer.max_size(), 6);
+
+    buffer.push(0, 7);
+    buffer.push(1, 8);
+    drained.clear();
+    buffer.drain([&drained](int x) { drained.push_back(x); });
+    ASSERT_EQ(drained, std::vector<int>({7, 8}));
+    ASSERT_EQ(buffer.overwritten(), 1);
+}
+
+TEST(BufferTestSuite, ShardedConcurrentDrainTest) {
+    ShardedBuffer<int> buffer(4, 4096);
+    std::atomic<size_t> drained = 0;
+    std::atomic<bool> done = false;
+
+    auto drainer = [&]() {
+        while (!done.load()) {
+            drained += buffer.drain([](int) {});
+        }
+    };
+    std::thread first(drainer);
+    std::thread second(drainer);
+
+    std::vector<std::thread> producers;
+    for (size_t shard = 0; shard < 4; ++shard) {
+        producers.emplace_back([&buffer, shard]() {
+            for (int i = 0; i < 2000; ++i) {
+                buffer.push(shard, i);
+            }
+        });
+    }
+    for (std::thread& producer: producers) {
+        producer.join();
+    }
+    done = true;
+    first.join();
+    second.join();
+    drained += buffer.drain([](int) {});
+
+    ASSERT_EQ(drained.load(), 8000);
+    ASSERT_EQ(buffer.overwritten(), 0);
+    ASSERT_EQ(buffer.max_size(), 4 * 4096);
+}
+
+TEST(BufferTestSuite, ShardedEmptyShardTest) {
+    ShardedBuffer<int> buffer(2, 0);
+    ASSERT_THROW(buffer.push(0, 1), std::invalid_argument);
+    ASSERT_EQ(buffer.overwritten(), 0);
+}
+
+TEST(BufferTestSuite, LowerBoundKeyStaticTest) {
+    BufferStatic<int> buffer(6);
+    for (int i = 0; i < 10; ++i) {
+        buffer.push(i * 10);
+    }
+
+    ASSERT_EQ(buffer.lower_bound_key(0), 0);
+    ASSERT_EQ(buffer.lower_bound_key(40), 0);
+    ASSERT_EQ(buffer.lower_bound_key(55), 2);
+    ASSERT_EQ(buffer.lower_bound_key(80), 4);
+    ASSERT_EQ(buffer.lower_bound_key(1000), 6);
+
+    auto [first, second] = buffer.range(45, 85);
+    std::vector<int> found(first.begin(), first.end());
+    found.insert(found.end(), second.begin(), second.end());
+    ASSERT_EQ(found, std::vector<int>({50, 60, 70, 80}));
+}
+
+TEST(BufferTestSuite, ExpireBeforeDinamicTest) {
+    struct Record {
+        int64_t timestamp;
+        int value;
+    };
+    auto timestamp = [](const Record& record) { return record.timestamp; };
+
+    BufferDynamic<Record> buffer(4);
+    for (int i = 0; i < 4; ++i) {
+        buffer.push({i * 100, i});
+    }
+    buffer.pop();
+    buffer.pop();
+    buffer.push({400, 4});
+    buffer.push({500, 5});
+
+    ASSERT_EQ(buffer.expire_before(int64_t(450), timestamp), 3);
+    ASSERT_EQ(buffer.size(), 1);
+    ASSERT_EQ(buffer[0].value, 5);
+
+    ASSERT_EQ(buffer.expire_before(int64_t(1000), timestamp), 1);
+    ASSERT_TRUE(buffer.empty());
+}
+
+TEST(BufferTestSuite, BroadcastGatingTest) {
+    BroadcastBuffer<int> buffer(4);
+    BroadcastBuffer<int>::Reader& fast = buffer.add_reader();
+    BroadcastBuffer<int>::Reader& slow = buffer.add_reader();
+
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(buffer.try_push(i));
+    }
+    ASSERT_FALSE(buffer.try_push(4));
+
+    BroadcastBuffer<int>::Batch batch = fast.claim();
+    ASSERT_EQ(batch.count, 4);
+    fast.release(batch);
+    ASSERT_FALSE(buffer.try_push(4));
+
+    batch = slow.claim(2);
+    ASSERT_EQ(batch.count, 2);
+    ASSERT_EQ(slow[batch.first], 0);
+    ASSERT_EQ(slow[batch.first + 1], 1);
+    ASSERT_TRUE(slow.release(batch));
+
+    ASSERT_TRUE(buffer.try_push(4));
+    ASSERT_TRUE(buffer.try_push(5));
+    ASSERT_FALSE(buffer.try_push(6));
+
+    int element;
+    ASSERT_TRUE(fast.try_read(element));
+    ASSERT_EQ(element, 4);
+    ASSERT_EQ(slow.available(), 4);
+}
+
+TEST(BufferTestSuite, BroadcastLossyTest) {
+    BroadcastBuffer<int> buffer(4, true);
+    BroadcastBuffer<int>::Reader& reader = buffer.add_reader();
+
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(buffer.try_push(i));
+    }
+
+    BroadcastBuffer<int>::Batch batch = reader.claim();
+    ASSERT_EQ(reader.overruns(), 6);
+    ASSERT_EQ(batch.count, 4);
+    ASSERT_EQ(reader[batch.first], 6);
+
+    buffer.push(10);
+    ASSERT_FALSE(reader.release(batch));
+}
+
+TEST(BufferTestSuite, BroadcastSizeTest) {
+    ASSERT_ANY_THROW(BroadcastBuffer<int>(0));
+    ASSERT_ANY_THROW(BroadcastBuffer<int>(5));
+    ASSERT_EQ(BroadcastBuffer<int>(8).max_size(), 8);
+}
+
+TEST(BufferTestSuite, BroadcastConcurrentTest) {
+    BroadcastBuffer<int64_t> buffer(64);
+    std::vector<BroadcastBuffer<int64_t>::Reader*> readers;
+    for (int i = 0; i < 3; ++i) {
+        readers.push_back(&buffer.add_reader());
+    }
+
+    std::vector<int64_t> sums(3, 0);
+    std::vector<std::thread> consumers;
+    for (int i = 0; i < 3; ++i) {
+        consumers.emplace_back([&readers, &sums, i]() {
+            int64_t received = 0;
+            while (received < 10000) {
+                BroadcastBuffer<int64_t>::Batch batch = readers[i]->claim();
+                for (uint64_t sequence = batch.first; sequence < batch.first + batch.count; ++sequence) {
+                    sums[i] += (*readers[i])[sequence];
+                }
+                readers[i]->release(batch);
+                received += batch.count;
+            }
+        });
+    }
+
+    for (int64_t i = 0; i < 10000; ++i) {
+        buffer.push(i);
+    }
+    for (std::thread& consumer: consumers) {
+        consumer.join();
+    }
+
+    for (int64_t sum: sums) {
+        ASSERT_EQ(sum, 10000 * 9999 / 2);
+    }
+}
+
+TEST(BufferTestSuite, BroadcastLossyConcurrentTest) {
+    struct Wide {
+        int64_t values[4];
+    };
+
+    BroadcastBuffer<Wide> buffer(4, true);
+    BroadcastBuffer<Wide>::Reader& reader = buffer.add_reader();
+    std::atomic<bool> done = false;
+
+    std::thread producer([&buffer, &done]() {
+        for (int64_t i = 0; i < 200000; ++i) {
+            buffer.push({i, i, i, i});
+        }
+        done = true;
+    });
+
+    int64_t last = -1;
+    size_t received = 0;
+    while (!done.load() || reader.available() != 0) {
+        BroadcastBuffer<Wide>::Batch batch = reader.claim();
+        std::vector<Wide> copies;
+        for (uint64_t sequence = batch.first; sequence < batch.first + batch.count; ++sequence) {
+            copies.push_back(reader[sequence]);
+        }
+        if (!reader.release(batch)) {
+            continue;
+        }
+
+        for (const Wide& element: copies) {
+            ASSERT_EQ(element.values[0], element.values[1]);
+            ASSERT_EQ(element.values[0], element.values[2]);
+            ASSERT_EQ(element.values[0], element.values[3]);
+            ASSERT_GT(element.values[0], last);
+            last = element.values[0];
+            ++received;
+        }
+    }
+    producer.join();
+
+    ASSERT_EQ(last, 199999);
+    ASSERT_GT(received, 0);
+}
+
+std::span<const std::byte> AsBytes(const std::string& text) {
+    return std::as_bytes(std::span<const char>(text.data(), text.size()));
+}
+
+std::string AsString(std::span<const std::byte> bytes) {
+    return std::string(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+}
+
+TEST(BufferTestSuite, RecordPushAndPopTest) {
+    RecordBuffer<> buffer(64);
+    ASSERT_TRUE(buffer.try_push(AsBytes("hello")));
+    ASSERT_TRUE(buffer.try_push(AsBytes("variable length")));
+    ASSERT_TRUE(buffer.try_push(AsBytes("")));
+    ASSERT_FALSE(buffer.try_push(AsBytes("does not fit any more")));
+
+    ASSERT_EQ(buffer.size(), 3);
+    ASSERT_EQ(AsString(buffer.peek()), "hello");
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(buffer.peek().data()) % 8, 0);
+    buffer.pop();
+    ASSERT_EQ(AsString(buffer.peek()), "variable length");
+    buffer.pop();
+
+    ASSERT_TRUE(buffer.try_push(AsBytes("wraps around")));
+    ASSERT_EQ(AsString(buffer.peek()), "");
+    buffer.pop();
+    ASSERT_EQ(AsString(buffer.peek()), "wraps around");
+    buffer.pop();
+    ASSERT_TRUE(buffer.empty());
+    ASSERT_THROW(buffer.pop(), std::invalid_argument);
+}
+
+TEST(BufferTestSuite, RecordOverwriteTest) {
+    RecordBuffer<> buffer(100, true);
+    for (int i = 0; i < 50; ++i) {
+        ASSERT_TRUE(buffer.try_push(AsBytes("record " + std::to_string(i))));
+    }
+
+    ASSERT_FALSE(buffer.try_push(AsBytes(std::string(200, 'x'))));
+    ASSERT_EQ(buffer.size() + buffer.evicted(), 50);
+    ASSERT_LE(buffer.bytes_used(), buffer.max_size());
+
+    for (int i = 50 - buffer.size(); i < 50; ++i) {
+        ASSERT_EQ(AsString(buffer.peek()), "record " + std::to_string(i));
+        buffer.pop();
+    }
+}
+
+TEST(BufferTestSuite, OverflowPolicyTest) {
+    static_assert(!std::is_polymorphic_v<BufferStatic<int>>);
+    static_assert(!std::is_polymorphic_v<BufferDynamic<int>>);
+    static_assert(!std::is_convertible_v<RollingHashBuffer<char>&, BufferStatic<char>&>);
+
+    BufferRejecting<int> buffer(3);
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(buffer.push(i));
+    }
+    ASSERT_FALSE(buffer.push(3));
+
+    buffer.pop();
+    ASSERT_TRUE(buffer.push(4));
+    ASSERT_EQ(buffer[0], 1);
+    ASSERT_EQ(buffer[2], 4);
+
+    BufferBounded<int, OverwriteOldest> overwriting(2);
+    ASSERT_TRUE(overwriting.push(1));
+    ASSERT_TRUE(overwriting.push(2));
+    ASSERT_TRUE(overwriting.push(3));
+    ASSERT_EQ(overwriting[0], 2);
+
+    BufferStatic<int> empty(0);
+    try {
+        empty.push(1);
+        FAIL();
+    } catch (const std::invalid_argument& error) {
+        ASSERT_STREQ(error.what(), "Buffer size not specified");
+    }
+    ASSERT_THROW(BufferRejecting<int>(0).push(1), std::invalid_argument);
+}
+
+TEST(BufferTestSuite, SmallBufferDinamicTest) {
+    SmallBufferDynamic<int, 4> buffer;
+    for (int i = 0; i < 4; ++i) {
+        buffer.push(i);
+    }
+
+    ASSERT_EQ(buffer.max_size(), 4);
+    ASSERT_GE(reinterpret_cast<char*>(&buffer[0]), reinterpret_cast<char*>(&buffer));
+    ASSERT_LT(reinterpret_cast<char*>(&buffer[0]), reinterpret_cast<char*>(&buffer) + sizeof(buffer));
+
+    for (int i = 4; i < 10; ++i) {
+        buffer.push(i);
+    }
+    ASSERT_EQ(buffer.max_size(), 16);
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_EQ(buffer[i], i);
+    }
+
+    for (int i = 0; i < 8; ++i) {
+        buffer.pop();
+    }
+    buffer.shrink_to_fit();
+    ASSERT_EQ(buffer.max_size(), 2);
+    ASSERT_EQ(buffer[0], 8);
+    ASSERT_EQ(buffer[1], 9);
+}
+
+TEST(BufferTestSuite, SmallBufferLimitsDinamicTest) {
+    SmallBufferDynamic<int, 4> bounded;
+    bounded.set_max_capacity(2);
+    for (int i = 0; i < 5; ++i) {
+        bounded.push(i);
+    }
+    ASSERT_EQ(bounded.size(), 2);
+    ASSERT_EQ(bounded.max_size(), 2);
+    ASSERT_EQ(bounded[0], 3);
+    ASSERT_EQ(bounded[1], 4);
+
+    SmallBufferDynamic<int, 16> buffer;
+    for (int i = 0; i < 5; ++i) {
+        buffer.push(i);
+    }
+    buffer.pop();
+    buffer.pop();
+
+    buffer.shrink_to_fit();
+    ASSERT_EQ(buffer.max_size(), 3);
+    ASSERT_GE(reinterpret_cast<char*>(&buffer[0]), reinterpret_cast<char*>(&buffer));
+    ASSERT_LT(reinterpret_cast<char*>(&buffer[0]), reinterpret_cast<char*>(&buffer) + sizeof(buffer));
+
+    buffer.set_max_capacity(8);
+    buffer.push(5);
+    ASSERT_GE(reinterpret_cast<char*>(&buffer[0]), reinterpret_cast<char*>(&buffer));
+    ASSERT_LT(reinterpret_cast<char*>(&buffer[0]), reinterpret_cast<char*>(&buffer) + sizeof(buffer));
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_EQ(buffer[i], i + 2);
+    }
+}
+
+template<typename Container>
+concept BaseSwappable = requires(Container& x, Container& y) { x.swap(y); };
+
+TEST(BufferTestSuite, SmallBufferConstructorsDinamicTest) {
+    static_assert(!BaseSwappable<Buffer<int>>);
+    static_assert(BaseSwappable<BufferStatic<int>>);
+
+    SmallBufferDynamic<int, 16> sized(8);
+    SmallBufferDynamic<int, 16> listed = {1, 2, 3};
+    SmallBufferDynamic<int, 16> filled(5, 7);
+    SmallBufferDynamic<int, 16> copied(listed);
+    SmallBufferDynamic<int, 2> spilled = {1, 2, 3};
+    for (int i = 0; i < 8; ++i) {
+        sized.push(i);
+    }
+
+    auto inside = [](auto& buffer) {
+        char* element = reinterpret_cast<char*>(&buffer[0]);
+        char* object = reinterpret_cast<char*>(&buffer);
+        return element >= object && element < object + sizeof(buffer);
+    };
+    ASSERT_TRUE(inside(sized));
+    ASSERT_TRUE(inside(listed));
+    ASSERT_TRUE(inside(filled));
+    ASSERT_TRUE(inside(copied));
+    ASSERT_FALSE(inside(spilled));
+
+    ASSERT_EQ(sized.max_size(), 8);
+    ASSERT_EQ(sized[7], 7);
+    ASSERT_EQ(filled.size(), 5);
+    ASSERT_EQ(filled[4], 7);
+    ASSERT_TRUE(copied == listed);
+    ASSERT_EQ(spilled[2], 3);
+
+    copied.push(4);
+    ASSERT_EQ(copied.size(), 4);
+    ASSERT_EQ(listed.size(), 3);
+}
+
+TEST(BufferTestSuite, SmallBufferSwapAndSnapshotDinamicTest) {
+    SmallBufferDynamic<int, 8> buffer_1;
+    SmallBufferDynamic<int, 8> buffer_2;
+    for (int i = 0; i < 3; ++i) {
+        buffer_1.push(i);
+        buffer_2.push(i + 10);
+    }
+
+    BufferSnapshot<int> snapshot = buffer_1.snapshot();
+    buffer_1.swap(buffer_2);
+    buffer_2.push(3);
+
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_EQ(buffer_1[i], i + 10);
+        ASSERT_EQ(buffer_2[i], i);
+        ASSERT_EQ(snapshot[i], i);
+    }
+    ASSERT_EQ(buffer_2[3], 3);
+}